@@ -12,11 +12,46 @@
 #ifndef MEMSTAX_H
 #define MEMSTAX_H
 
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <climits>
+#include <condition_variable>
+#include <new>
 #include <iostream>
+#include <limits>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <fstream>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Polymorphic allocators are only avaliable where the standard library
+// ships them
+#if __has_include(<memory_resource>)
+#define MEMSTAX_MEMORY_RESOURCE 1
+#include <memory_resource>
+#endif
+
+// Slab bitmaps are scanned four words at a time where AVX2 is avaliable
+#if defined(__AVX2__)
+#define MEMSTAX_AVX2 1
+#include <immintrin.h>
+#endif
+
+// Trace files can only be memory mapped where POSIX mmap is avaliable
+#if defined(__unix__) || defined(__APPLE__)
+#define MEMSTAX_MAPPED_TRACE 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace Stax
 {
@@ -59,6 +94,16 @@ namespace Stax
     MEMFLAGS_NONE = 0x00
     , MEMFLAGS_DISABLE_DEBUG_MSG = 0x01
     , MEMFLAGS_OVERRIDE_DOUBLE_ALLOC = 0x02
+    //! Heap only bumps forward and is released with markers or a reset
+    , MEMFLAGS_MONOTONIC = 0x04
+    //! Monotonic heaps run destructors of non trivial objects on rewind
+    , MEMFLAGS_TRACK_DESTRUCTORS = 0x08
+    //! Heap can be shared between threads which allocate from local caches
+    , MEMFLAGS_THREAD_SAFE = 0x10
+    //! Each page is a slab of equal sized slots tracked by a bitmap
+    , MEMFLAGS_SLAB = 0x20
+    //! Each page is split into power of two blocks by a buddy allocator
+    , MEMFLAGS_BUDDY = 0x40
   };
 
   /*!
@@ -70,6 +115,76 @@ namespace Stax
     , MEMCALL_DEALLOC
     , MEMCALL_MEM_ERR
     , MEMCALL_INVALID_MEM
+    , MEMCALL_MEM_LIMIT
+  };
+
+  /*!
+   * An enum used to choose what an asynchronous trace does when a message
+   * is logged while its ring buffer is full.
+   */
+  enum MEMTRACEFULL
+  {
+    //! Wait for the writer thread to make room for the message
+    MEMTRACEFULL_BLOCK = 0
+    //! Drop the message and count it as dropped
+    , MEMTRACEFULL_DROP
+  };
+
+  /*!
+   * An enum used to choose how a trace writes its messages.
+   */
+  enum MEMTRACEFORMAT
+  {
+    //! A line of text for every message
+    MEMTRACEFORMAT_TEXT = 0
+    //! Compact varint encoded records which are read with MemTraceReader
+    , MEMTRACEFORMAT_BINARY
+  };
+
+  /*!
+   * A record of a binary trace as read back by MemTraceReader.
+   */
+  struct MemTraceRecord
+  {
+    //! The MEMCALL of an event or MemTraceRecord::textRecord for a message
+    uint8_t type;
+    //! Nanoseconds on the steady clock when the event happened
+    uint64_t timestamp;
+    //! The size of the memory the event is about
+    uint64_t memSize;
+    //! A small number naming the thread that logged the record
+    uint32_t threadId;
+    //! The address of the memory the event is about, or 0 if unknown
+    uint64_t address;
+    //! The text of a message record
+    std::string msg;
+
+    //! Type of records holding a text message instead of an event
+    static constexpr uint8_t textRecord = 0x80;
+    //! Bytes starting every session of a binary trace
+    static constexpr char headerMagic[4] = { 'M', 'S', 'T', 'X' };
+    //! Version of the binary trace format written after the magic bytes
+    static constexpr uint8_t headerVersion = 1;
+  };
+
+  /*!
+   * A snapshot of the counters kept by a MemCallback. Every counter is 64
+   * bits so none of them wrap in the lifetime of a program.
+   */
+  struct MemStats
+  {
+    //! Number of allocations reported to the callback
+    uint64_t allocs;
+    //! Number of deallocations reported to the callback
+    uint64_t deallocs;
+    //! Total bytes of every allocation reported
+    uint64_t bytesAllocated;
+    //! Total bytes of every deallocation reported
+    uint64_t bytesDeallocated;
+    //! Bytes allocated that have not been deallocated yet
+    uint64_t memInUse;
+    //! Number of allocation errors, invalid memory, and budget messages
+    uint64_t errors;
   };
 
   //! A definition used for callback functions
@@ -88,6 +203,9 @@ namespace Stax
    *    - Printing a trace message to the file or console
    *    - Getting the most recent trace message
    *    - Clearing a trace file
+   *    - Writing trace messages from a background thread
+   *    - Writing compact binary records instead of text
+   *    - Writing to a memory mapped trace file
    *
    * \deprecated
    *    N/A
@@ -114,6 +232,11 @@ namespace Stax
       MemTrace(const std::string &tracePath = "", const bool &clearContents = false
           , MEMERR *error = nullptr, memtracefunc newTraceFunc = PrintMessage)
         : traceLog(false), traceFunc(newTraceFunc), filePath(tracePath)
+        , ringSlots(nullptr), ringCapacity(0), fullPolicy(MEMTRACEFULL_BLOCK)
+        , enqueuePos(0), writtenPos(0), droppedMsgs(0), writerRunning(false)
+        , flushWaiters(0), format(MEMTRACEFORMAT_TEXT), prevTimestamp(0)
+        , prevAddress(0), mappedFd(-1), mappedMem(nullptr), mappedCapacity(0)
+        , mappedSize(0), mapChunkSize(0)
       {
         // Checks if a valid trace function has been given in order to enable
         // trace functionality.
@@ -175,6 +298,10 @@ namespace Stax
        */
       ~MemTrace()
       {
+        // Write out anything still waiting in the ring buffer
+        StopAsyncWriter();
+        UnmapTraceFile();
+
         // If the trace function is valid then disable tracing on destruction
         if(traceFunc)
         {
@@ -206,6 +333,22 @@ namespace Stax
           return MEMERR_UNINITALIZED;
         }
 
+        // Hand the message to the writer thread if there is one
+        if(ringSlots)
+        {
+          return PushRecord(msg.data(), msg.size(), false);
+        }
+
+        // Binary and mapped traces write the message as a record
+        if(format == MEMTRACEFORMAT_BINARY || mappedFd >= 0)
+        {
+          std::string &buffer = RecordBuffer();
+          AppendText(msg, buffer);
+          std::lock_guard<std::mutex> lock(recordMutex);
+          WriteBatch(buffer);
+          return MEMERR_NO_ERR;
+        }
+
         // Make sure that the trace file is open...
         // if it is not then set the file to nullptr 
         if(traceFile.is_open())
@@ -218,6 +361,396 @@ namespace Stax
         }
       }
 
+      /*!
+       * Logs a memory event such as an allocation. Text traces describe the
+       * event with a message, while binary traces write a record holding
+       * the event, its size, the time, the thread, and the address.
+       *
+       * \param msg
+       *    The callback message of the event
+       * \param memSize
+       *    The size of the memory the event is about
+       * \param address
+       *    The address of the memory the event is about if it is known
+       *
+       * \returns
+       *    Returns a memory error.
+       */
+      MEMERR LogEvent(const MEMCALL &msg, const size_t &memSize
+          , const void *address = nullptr)
+      {
+        if(!traceLog)
+        {
+          return MEMERR_UNINITALIZED;
+        }
+
+        TraceEvent event;
+        event.timestamp = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now().time_since_epoch()).count());
+        event.memSize = memSize;
+        event.address = reinterpret_cast<uintptr_t>(address);
+        event.threadId = TraceThreadId();
+        event.type = static_cast<uint8_t>(msg);
+
+        // The writer thread formats the event if there is one
+        if(ringSlots)
+        {
+          return PushRecord(reinterpret_cast<const char*>(&event)
+              , sizeof(event), true);
+        }
+
+        // Records are relative to the one before them so each has to be
+        // encoded and written before another thread's
+        if(format == MEMTRACEFORMAT_BINARY || mappedFd >= 0)
+        {
+          std::string &buffer = RecordBuffer();
+          std::lock_guard<std::mutex> lock(recordMutex);
+          AppendEvent(event, buffer);
+          WriteBatch(buffer);
+          return MEMERR_NO_ERR;
+        }
+
+        return traceFunc(FormatEventMsg(event.type, memSize)
+            , traceFile.is_open() ? &traceFile : nullptr);
+      }
+
+      /*!
+       * Sets how the trace writes its messages. Binary traces must have a
+       * trace file and write to it directly instead of through the trace
+       * function. Every binary session starts with a header so a file can
+       * be appended to by several runs. Must be set before the async
+       * writer is started.
+       *
+       * \param in_format
+       *    The format messages are written in
+       *
+       * \returns
+       *    A memory error result.
+       */
+      MEMERR SetFormat(const MEMTRACEFORMAT &in_format)
+      {
+        if(ringSlots || mappedFd >= 0)
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+        if(in_format == format)
+        {
+          return MEMERR_NO_ERR;
+        }
+        if(in_format == MEMTRACEFORMAT_BINARY && !traceFile.is_open())
+        {
+          return MEMERR_INVALID_FILE;
+        }
+
+        format = in_format;
+
+        // Reopen the file so binary records aren't changed by the platform
+        if(traceFile.is_open())
+        {
+          traceFile.close();
+          traceFile.open(filePath, FileMode());
+          if(!traceFile.is_open())
+          {
+            return MEMERR_INVALID_FILE;
+          }
+        }
+        if(format == MEMTRACEFORMAT_BINARY)
+        {
+          WriteHeader();
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Switches the trace file from the file stream to a memory mapping so
+       * that messages are written with plain stores instead of write calls.
+       * The file grows by a whole chunk whenever the mapping fills up and is
+       * cut back to the length written when it is unmapped. Messages already
+       * written survive the program crashing without being flushed, though
+       * the file may then end in zeroed padding. Mapping a text trace again
+       * cuts the padding off, while MemTraceReader skips the padding of a
+       * binary trace that later sessions were appended to. Only avaliable
+       * on POSIX systems, and text traces must use the default trace
+       * function. The format must be set and the async writer stopped
+       * beforehand. Threads may log to the mapped file at once, but mapping
+       * and unmapping must not happen while other threads are logging.
+       *
+       * \param in_chunkSize
+       *    The number of bytes the file grows by at a time
+       *
+       * \returns
+       *    A memory error result.
+       */
+      MEMERR MapTraceFile(const size_t &in_chunkSize = defaultMapChunkSize)
+      {
+        if(!traceLog)
+        {
+          return MEMERR_UNINITALIZED;
+        }
+        if(mappedFd >= 0)
+        {
+          return MEMERR_DOUBLE_ALLOC;
+        }
+        if(ringSlots || !in_chunkSize
+            || (format == MEMTRACEFORMAT_TEXT && traceFunc != PrintMessage))
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+        if(filePath.empty())
+        {
+          return MEMERR_INVALID_FILE;
+        }
+
+#ifdef MEMSTAX_MAPPED_TRACE
+        // Keep writing through the stream if the file can't be opened
+        const int fd = open(filePath.c_str(), O_RDWR | O_CREAT, 0644);
+        struct stat fileStat;
+        if(fd < 0)
+        {
+          return MEMERR_INVALID_FILE;
+        }
+        if(fstat(fd, &fileStat) != 0)
+        {
+          close(fd);
+          return MEMERR_INVALID_FILE;
+        }
+
+        // Hand the file over from the stream to the mapping
+        if(traceFile.is_open())
+        {
+          traceFile.close();
+        }
+        mappedFd = fd;
+
+        // Messages are appended after whatever the file already holds
+        mapChunkSize = in_chunkSize;
+        mappedSize = static_cast<size_t>(fileStat.st_size);
+        mappedCapacity = 0;
+        if(mappedSize && !ReserveMapped(0))
+        {
+          UnmapTraceFile();
+          return MEMERR_OUT_OF_MEM;
+        }
+
+        // Text lines never hold zeros so padding left by a crash is cut off.
+        // Binary records can end in a zero so readers skip it instead.
+        if(format == MEMTRACEFORMAT_TEXT)
+        {
+          while(mappedSize && !mappedMem[mappedSize - 1])
+          {
+            --mappedSize;
+          }
+        }
+
+        return MEMERR_NO_ERR;
+#else
+        return MEMERR_INVALID_FILE;
+#endif
+      }
+
+      /*!
+       * Unmaps a memory mapped trace file, cutting it down to the length
+       * written, and goes back to writing through the file stream. Does
+       * nothing if the trace file isn't mapped.
+       *
+       * \returns
+       *    A memory error result.
+       */
+      MEMERR UnmapTraceFile()
+      {
+        if(mappedFd < 0)
+        {
+          return MEMERR_NO_ERR;
+        }
+        if(ringSlots)
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        MEMERR error = MEMERR_NO_ERR;
+#ifdef MEMSTAX_MAPPED_TRACE
+        if(mappedMem)
+        {
+          munmap(mappedMem, mappedCapacity);
+        }
+        if(ftruncate(mappedFd, static_cast<off_t>(mappedSize)) != 0)
+        {
+          error = MEMERR_INVALID_FILE;
+        }
+        close(mappedFd);
+#endif
+        mappedFd = -1;
+        mappedMem = nullptr;
+        mappedCapacity = 0;
+        mappedSize = 0;
+
+        // Keep tracing through the file stream
+        traceFile.open(filePath, FileMode());
+        if(!traceFile.is_open())
+        {
+          error = MEMERR_INVALID_FILE;
+        }
+
+        return error;
+      }
+
+      //! Default number of bytes a mapped trace file grows by at a time
+      static inline const size_t defaultMapChunkSize = 16 * 1024 * 1024;
+
+      /*!
+       * Starts a background thread that writes trace messages for the trace
+       * instance. Logging a message then only copies it into a lock free
+       * ring buffer, and the writer thread gathers waiting messages into
+       * large writes. While the writer is running the trace file must not
+       * be cleared or written to through GetFile.
+       *
+       * \param in_ringCapacity
+       *    The number of slots in the ring buffer which must be a power of
+       *    two. Each slot holds a message of up to 112 bytes and longer
+       *    messages take several slots.
+       * \param in_fullPolicy
+       *    Wether logging waits or drops the message when the ring is full
+       *
+       * \returns
+       *    A memory error result.
+       */
+      MEMERR StartAsyncWriter(const size_t &in_ringCapacity = defaultRingCapacity
+          , const MEMTRACEFULL &in_fullPolicy = MEMTRACEFULL_BLOCK)
+      {
+        if(!traceLog || !traceFunc)
+        {
+          return MEMERR_UNINITALIZED;
+        }
+        if(ringSlots)
+        {
+          return MEMERR_DOUBLE_ALLOC;
+        }
+        if(!in_ringCapacity || (in_ringCapacity & (in_ringCapacity - 1)))
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        try
+        {
+          ringSlots = new RingSlot[in_ringCapacity];
+        }
+        catch(const std::bad_alloc &e)
+        {
+          return MEMERR_OUT_OF_MEM;
+        }
+
+        // A slot is free for the lap that reaches it once its sequence
+        // matches its position
+        ringCapacity = in_ringCapacity;
+        for(size_t i = 0; i < ringCapacity; ++i)
+        {
+          ringSlots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        fullPolicy = in_fullPolicy;
+        enqueuePos.store(0, std::memory_order_relaxed);
+        writtenPos.store(0, std::memory_order_relaxed);
+        writerRunning.store(true, std::memory_order_release);
+
+        try
+        {
+          writerThread = std::thread(&MemTrace::WriteRecords, this);
+        }
+        catch(const std::exception &e)
+        {
+          writerRunning.store(false, std::memory_order_relaxed);
+          delete[] ringSlots;
+          ringSlots = nullptr;
+          return MEMERR_UNKNOWN;
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Writes out every message still in the ring buffer and stops the
+       * writer thread so messages are traced synchronously again. Must not
+       * be called while other threads are logging.
+       */
+      void StopAsyncWriter()
+      {
+        if(!ringSlots)
+        {
+          return;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(writerMutex);
+          writerRunning.store(false, std::memory_order_release);
+        }
+        writerCv.notify_one();
+        writerThread.join();
+
+        delete[] ringSlots;
+        ringSlots = nullptr;
+        ringCapacity = 0;
+      }
+
+      /*!
+       * Waits until every message logged before the call has been written
+       * and flushed to the trace file or console.
+       *
+       * \returns
+       *    A memory error result.
+       */
+      MEMERR Flush()
+      {
+        if(!traceLog)
+        {
+          return MEMERR_UNINITALIZED;
+        }
+
+        // Without a writer thread messages are already written so only the
+        // stream needs flushing. Mapped files never need flushing.
+        if(!ringSlots)
+        {
+          if(mappedFd >= 0)
+          {
+            return MEMERR_NO_ERR;
+          }
+          else if(traceFile.is_open())
+          {
+            traceFile.flush();
+          }
+          else
+          {
+            std::cout.flush();
+          }
+
+          return MEMERR_NO_ERR;
+        }
+
+        const size_t target = enqueuePos.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(writerMutex);
+        ++flushWaiters;
+        writerCv.notify_one();
+        flushCv.wait(lock, [this, target]()
+        {
+          return writtenPos.load(std::memory_order_acquire) >= target;
+        });
+        --flushWaiters;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Gets the number of messages dropped because the ring buffer was
+       * full while using MEMTRACEFULL_DROP.
+       */
+      uint64_t GetDroppedMsgs() const
+      {
+        return droppedMsgs.load(std::memory_order_relaxed);
+      }
+
+      //! Default number of slots in the ring buffer of an async trace
+      static inline const size_t defaultRingCapacity = 1024;
+
       /*!
        * Clears the current trace file of the trace instance.
        * If the file is open then closes it and then clears it, if not
@@ -234,6 +767,12 @@ namespace Stax
           return MEMERR_INVALID_FILE;
         }
 
+        // A mapped file is in use by the mapping
+        if(mappedFd >= 0)
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
         // Close the file if it is currently open
         if(!traceFile.is_open())
         {
@@ -247,12 +786,18 @@ namespace Stax
         }
         // Close the file and reopen for appending as normal
         traceFile.close();
-        traceFile.open(filePath, std::ios::out | std::ios::app);
+        traceFile.open(filePath, FileMode());
         if(!traceFile.is_open())
         {
           return MEMERR_INVALID_FILE;
         }
 
+        // A cleared binary trace still needs to start with a header
+        if(format == MEMTRACEFORMAT_BINARY)
+        {
+          WriteHeader();
+        }
+
         return MEMERR_NO_ERR;
       }
  
@@ -323,26 +868,5280 @@ namespace Stax
         return MEMERR_NO_ERR;
       }
 
-      //! A bool for telling the log system wether or no logging is active.
-      bool traceLog;
-      //! A pointer to a functino which matches the trace func definition
-      memtracefunc traceFunc;
-      //! A file that can be used for writting trace messages
-      std::fstream traceFile;
-      //! A string that holds the file path of the trace file.
-      std::string filePath;
-  };
+      /*!
+       * A slot of the async ring buffer. A message starts in a slot holding
+       * its size and continues through the following slots if it is too
+       * long for one. Slots are a multiple of a cache line so producers
+       * writing neighbouring slots don't share lines.
+       */
+      struct alignas(64) RingSlot
+      {
+        //! Position of the slot in the lap it is waiting to be written or read
+        std::atomic<size_t> sequence;
+        //! Size of the message starting in this slot
+        uint32_t msgSize;
+        //! Wether the message is a TraceEvent instead of text
+        bool isEvent;
+        //! The part of the message held in this slot
+        char payload[112];
+      };
 
-  /*!
-   * \class 
-   *    MemCallback
+      /*!
+       * An event as it is handed to the writer thread before it is
+       * formatted.
+       */
+      struct TraceEvent
+      {
+        uint64_t timestamp;
+        uint64_t memSize;
+        uint64_t address;
+        uint32_t threadId;
+        uint8_t type;
+      };
+
+      //! Longest event message that can be formatted without reallocating
+      static constexpr size_t maxTraceMsgSize = 64;
+
+      //! Size of a batch gathered by the writer before it is written out
+      static inline const size_t asyncBatchSize = 64 * 1024;
+
+      /*!
+       * Copies a message into the ring buffer, waiting for space or dropping
+       * the message when the ring is full depending on the full policy.
+       */
+      MEMERR PushRecord(const char *msg, size_t msgSize, const bool &isEvent)
+      {
+        const size_t payloadSize = sizeof(RingSlot::payload);
+        size_t numOfSlots = msgSize ? (msgSize + payloadSize - 1) / payloadSize : 1;
+
+        // Messages longer than the whole ring are cut down to fit
+        if(numOfSlots > ringCapacity)
+        {
+          numOfSlots = ringCapacity;
+          msgSize = numOfSlots * payloadSize;
+        }
+
+        // Claim the slots by moving the enqueue position past them once the
+        // last one has been read by the writer. The writer reads in order
+        // so every slot before it is free as well.
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        while(true)
+        {
+          const size_t last = pos + numOfSlots - 1;
+          const size_t sequence = ringSlots[last & (ringCapacity - 1)]
+            .sequence.load(std::memory_order_acquire);
+          const intptr_t diff = static_cast<intptr_t>(sequence)
+            - static_cast<intptr_t>(last);
+
+          if(diff == 0)
+          {
+            if(enqueuePos.compare_exchange_weak(pos, pos + numOfSlots
+                  , std::memory_order_relaxed))
+            {
+              break;
+            }
+          }
+          // The ring is full
+          else if(diff < 0)
+          {
+            if(fullPolicy == MEMTRACEFULL_DROP)
+            {
+              droppedMsgs.fetch_add(1, std::memory_order_relaxed);
+              return MEMERR_OUT_OF_MEM;
+            }
+
+            writerCv.notify_one();
+            std::this_thread::yield();
+            pos = enqueuePos.load(std::memory_order_relaxed);
+          }
+          // Another thread claimed the slots first
+          else
+          {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+          }
+        }
+
+        // Copy the message across its slots and publish them with the first
+        // slot last so the writer sees the whole message at once
+        RingSlot &first = ringSlots[pos & (ringCapacity - 1)];
+        first.msgSize = static_cast<uint32_t>(msgSize);
+        first.isEvent = isEvent;
+        for(size_t i = 0; i < numOfSlots; ++i)
+        {
+          RingSlot &slot = ringSlots[(pos + i) & (ringCapacity - 1)];
+          const size_t offset = i * payloadSize;
+          const size_t size = (msgSize - offset < payloadSize)
+            ? msgSize - offset : payloadSize;
+          std::memcpy(slot.payload, msg + offset, size);
+        }
+        for(size_t i = numOfSlots; i-- > 0;)
+        {
+          ringSlots[(pos + i) & (ringCapacity - 1)].sequence.store(pos + i + 1
+              , std::memory_order_release);
+        }
+
+        // Wake the writer once the ring is getting full instead of on every
+        // message
+        if((pos & (ringCapacity / 2 - 1)) + numOfSlots > ringCapacity / 2
+            || ringCapacity < 2)
+        {
+          writerCv.notify_one();
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * The writer thread which moves messages out of the ring buffer in
+       * batches until it is stopped.
+       */
+      void WriteRecords()
+      {
+        const size_t payloadSize = sizeof(RingSlot::payload);
+        const bool batchWrites = (format == MEMTRACEFORMAT_BINARY)
+          || (traceFunc == PrintMessage);
+        std::string batch;
+        batch.reserve(asyncBatchSize);
+        std::string record;
+        size_t pos = 0;
+
+        while(true)
+        {
+          const bool running = writerRunning.load(std::memory_order_acquire);
+
+          // Move every published message out of the ring
+          while(true)
+          {
+            RingSlot &first = ringSlots[pos & (ringCapacity - 1)];
+            if(first.sequence.load(std::memory_order_acquire) != pos + 1)
+            {
+              break;
+            }
+
+            const size_t msgSize = first.msgSize;
+            const bool isEvent = first.isEvent;
+            const size_t numOfSlots = msgSize
+              ? (msgSize + payloadSize - 1) / payloadSize : 1;
+            record.clear();
+            for(size_t i = 0; i < numOfSlots; ++i)
+            {
+              RingSlot &slot = ringSlots[(pos + i) & (ringCapacity - 1)];
+              const size_t offset = i * payloadSize;
+              const size_t size = (msgSize - offset < payloadSize)
+                ? msgSize - offset : payloadSize;
+              record.append(slot.payload, size);
+            }
+
+            // Hand the slots back for the next lap
+            for(size_t i = 0; i < numOfSlots; ++i)
+            {
+              ringSlots[(pos + i) & (ringCapacity - 1)].sequence.store(
+                  pos + i + ringCapacity, std::memory_order_release);
+            }
+            pos += numOfSlots;
+
+            TraceEvent event;
+            if(isEvent)
+            {
+              std::memcpy(&event, record.data(), sizeof(event));
+            }
+
+            // The default trace function is replaced by large writes while
+            // custom trace functions still recieve each message
+            if(batchWrites)
+            {
+              if(isEvent)
+              {
+                AppendEvent(event, batch);
+              }
+              else
+              {
+                AppendText(record, batch);
+              }
+              if(batch.size() >= asyncBatchSize)
+              {
+                WriteBatch(batch);
+              }
+            }
+            else
+            {
+              traceFunc(isEvent ? FormatEventMsg(event.type, event.memSize)
+                  : record, traceFile.is_open() ? &traceFile : nullptr);
+            }
+          }
+          WriteBatch(batch);
+
+          // Let anyone flushing know how far the messages have been written
+          {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            writtenPos.store(pos, std::memory_order_release);
+          }
+          flushCv.notify_all();
+
+          if(!running)
+          {
+            return;
+          }
+
+          // Sleep until the ring fills up, someone flushes, or a moment
+          // passes so that messages don't wait long to be written
+          std::unique_lock<std::mutex> lock(writerMutex);
+          if(flushWaiters)
+          {
+            lock.unlock();
+            std::this_thread::yield();
+            continue;
+          }
+          writerCv.wait_for(lock, std::chrono::milliseconds(10));
+        }
+      }
+
+      /*!
+       * Appends an event to a batch in the trace's format. Binary events
+       * hold the time and address as differences from the previous record
+       * so that most records only take a few bytes.
+       */
+      void AppendEvent(const TraceEvent &event, std::string &batch)
+      {
+        if(format == MEMTRACEFORMAT_TEXT)
+        {
+          batch.append(FormatEventMsg(event.type, event.memSize));
+          batch.push_back('\n');
+          return;
+        }
+
+        batch.push_back(static_cast<char>(event.type));
+        AppendVarint(event.memSize, batch);
+        AppendVarint(ZigZag(event.timestamp - prevTimestamp), batch);
+        AppendVarint(event.threadId, batch);
+        AppendVarint(ZigZag(event.address - prevAddress), batch);
+        prevTimestamp = event.timestamp;
+        prevAddress = event.address;
+      }
+
+      //! Appends a text message to a batch in the trace's format
+      void AppendText(const std::string &msg, std::string &batch)
+      {
+        if(format == MEMTRACEFORMAT_TEXT)
+        {
+          batch.append(msg);
+          batch.push_back('\n');
+          return;
+        }
+
+        batch.push_back(static_cast<char>(MemTraceRecord::textRecord));
+        AppendVarint(msg.size(), batch);
+        batch.append(msg);
+      }
+
+      //! Writes the header that starts a binary session to the trace file
+      void WriteHeader()
+      {
+        std::string &buffer = RecordBuffer();
+        buffer.append(MemTraceRecord::headerMagic
+            , sizeof(MemTraceRecord::headerMagic));
+        buffer.push_back(static_cast<char>(MemTraceRecord::headerVersion));
+        WriteBatch(buffer);
+
+        // Records of the new session are relative to the header
+        prevTimestamp = 0;
+        prevAddress = 0;
+      }
+
+      /*!
+       * Makes sure the mapping has room for the given number of bytes past
+       * what has been written, growing the file and remapping it by whole
+       * chunks if it doesn't.
+       */
+      bool ReserveMapped(const size_t &size)
+      {
+        if(mappedSize + size <= mappedCapacity && mappedMem)
+        {
+          return true;
+        }
+
+#ifdef MEMSTAX_MAPPED_TRACE
+        const size_t newCapacity = ((mappedSize + size + mapChunkSize - 1)
+            / mapChunkSize) * mapChunkSize;
+        if(ftruncate(mappedFd, static_cast<off_t>(newCapacity)) != 0)
+        {
+          return false;
+        }
+
+        void *mem = mmap(nullptr, newCapacity, PROT_READ | PROT_WRITE
+            , MAP_SHARED, mappedFd, 0);
+        if(mem == MAP_FAILED)
+        {
+          return false;
+        }
+
+        if(mappedMem)
+        {
+          munmap(mappedMem, mappedCapacity);
+        }
+        mappedMem = static_cast<uint8_t*>(mem);
+        mappedCapacity = newCapacity;
+
+        return true;
+#else
+        return false;
+#endif
+      }
+
+      //! Appends a value 7 bits at a time with the high bit marking more
+      static void AppendVarint(uint64_t value, std::string &batch)
+      {
+        while(value >= 0x80)
+        {
+          batch.push_back(static_cast<char>((value & 0x7F) | 0x80));
+          value >>= 7;
+        }
+        batch.push_back(static_cast<char>(value));
+      }
+
+      //! Maps a difference so that small negative values stay small
+      static uint64_t ZigZag(const uint64_t &diff)
+      {
+        return (diff << 1) ^ (0 - (diff >> 63));
+      }
+
+      //! Gets the mode the trace file is opened with for its format
+      std::ios::openmode FileMode() const
+      {
+        std::ios::openmode mode = std::ios::out | std::ios::app;
+        if(format == MEMTRACEFORMAT_BINARY)
+        {
+          mode |= std::ios::binary;
+        }
+
+        return mode;
+      }
+
+      //! Gets an empty buffer owned by the calling thread for encoding
+      static std::string &RecordBuffer()
+      {
+        static thread_local std::string recordBuffer;
+        if(recordBuffer.capacity() < maxTraceMsgSize)
+        {
+          recordBuffer.reserve(maxTraceMsgSize);
+        }
+        recordBuffer.clear();
+
+        return recordBuffer;
+      }
+
+      /*!
+       * Gets a small number for the calling thread which is handed out in
+       * the order threads first log an event.
+       */
+      static uint32_t TraceThreadId()
+      {
+        static std::atomic<uint32_t> nextThreadId{1};
+        static thread_local const uint32_t threadId
+          = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+
+        return threadId;
+      }
+
+    public:
+      /*!
+       * Formats the message describing an event followed by its size into
+       * a buffer owned by the calling thread. The buffer keeps its capacity
+       * between messages so tracing doesn't allocate once a thread has
+       * traced its first one.
+       *
+       * \param type
+       *    The MEMCALL of the event
+       * \param memSize
+       *    The size written at the end of the message
+       *
+       * \returns
+       *    The formatted message which is only valid until the thread
+       *    formats its next message.
+       */
+      static const std::string &FormatEventMsg(const uint8_t &type
+          , const uint64_t &memSize)
+      {
+        // Check what callback is being performed
+        const char *traceMsg = "";
+        switch(type)
+        {
+          case MEMCALL_ALLOC:
+            traceMsg = "Allocating Memory of size: ";
+            break;
+          case MEMCALL_DEALLOC:
+            traceMsg = "Deallocating Memory of size: ";
+            break;
+          case MEMCALL_MEM_ERR:
+            traceMsg = "Error Allocating Memory of size: ";
+            break;
+          case MEMCALL_INVALID_MEM:
+            traceMsg = "Error Accessing Memory of size: ";
+            break;
+          case MEMCALL_MEM_LIMIT:
+            traceMsg = "Memory Budget Exceeded at size: ";
+        }
+
+        char digits[std::numeric_limits<uint64_t>::digits10 + 1];
+        const std::to_chars_result result
+          = std::to_chars(digits, digits + sizeof(digits), memSize);
+
+        // Messages get their own buffer so they can be passed back in to be
+        // encoded as records
+        static thread_local std::string traceBuffer;
+        if(traceBuffer.capacity() < maxTraceMsgSize)
+        {
+          traceBuffer.reserve(maxTraceMsgSize);
+        }
+        traceBuffer.assign(traceMsg);
+        traceBuffer.append(digits, result.ptr);
+
+        return traceBuffer;
+      }
+
+    private:
+      //! Writes a batch of messages to the trace file or console at once
+      void WriteBatch(std::string &batch)
+      {
+        if(batch.empty())
+        {
+          return;
+        }
+
+        // Mapped files are written with a copy. The batch is lost if the
+        // file can't grow to fit it.
+        if(mappedFd >= 0)
+        {
+          if(ReserveMapped(batch.size()))
+          {
+            std::memcpy(mappedMem + mappedSize, batch.data(), batch.size());
+            mappedSize += batch.size();
+          }
+          batch.clear();
+          return;
+        }
+
+        std::ostream &stream = traceFile.is_open()
+          ? static_cast<std::ostream&>(traceFile) : std::cout;
+        stream.write(batch.data(), batch.size());
+        stream.flush();
+        batch.clear();
+      }
+
+      //! A bool for telling the log system wether or no logging is active.
+      bool traceLog;
+      //! A pointer to a functino which matches the trace func definition
+      memtracefunc traceFunc;
+      //! A file that can be used for writting trace messages
+      std::fstream traceFile;
+      //! A string that holds the file path of the trace file.
+      std::string filePath;
+
+      //! Ring buffer of messages waiting for the writer thread if it is on
+      RingSlot *ringSlots;
+      //! Number of slots in the ring buffer
+      size_t ringCapacity;
+      //! What logging does when the ring buffer is full
+      MEMTRACEFULL fullPolicy;
+      //! Position of the next slot claimed by a message
+      std::atomic<size_t> enqueuePos;
+      //! Position up to which messages have been written out
+      std::atomic<size_t> writtenPos;
+      //! Number of messages dropped while the ring buffer was full
+      std::atomic<uint64_t> droppedMsgs;
+      //! Wether the writer thread should keep running
+      std::atomic<bool> writerRunning;
+      //! Number of threads waiting within Flush
+      size_t flushWaiters;
+      //! The writer thread
+      std::thread writerThread;
+      //! Guards the writer's sleep and flush notifications
+      std::mutex writerMutex;
+      //! Wakes the writer thread
+      std::condition_variable writerCv;
+      //! Wakes threads waiting within Flush
+      std::condition_variable flushCv;
+
+      //! The format messages are written in
+      MEMTRACEFORMAT format;
+      //! Time of the previous binary record
+      uint64_t prevTimestamp;
+      //! Address of the previous binary record
+      uint64_t prevAddress;
+      //! Guards the previous record and the file without the writer thread
+      std::mutex recordMutex;
+
+      //! Descriptor of the mapped trace file or -1 if it isn't mapped
+      int mappedFd;
+      //! The mapping of the trace file
+      uint8_t *mappedMem;
+      //! Number of bytes mapped
+      size_t mappedCapacity;
+      //! Number of bytes written to the mapped file
+      size_t mappedSize;
+      //! Number of bytes the mapped file grows by at a time
+      size_t mapChunkSize;
+  };
+
+  /*!
+   * \class MemTraceReader
+   * \brief
+   *    Reads the records of a binary trace back out of its bytes. Used by
+   *    the trace decoder and anything else summarizing binary traces.
+   *
+   * \deprecated
+   *    N/A
+   *
+   * \bug
+   *    N/A
+   */
+  class MemTraceReader
+  {
+    public:
+      /*!
+       * Creates a reader over the bytes of a binary trace which must stay
+       * alive while it is read.
+       */
+      MemTraceReader(const uint8_t *in_data, const size_t &in_dataSize)
+        : data(in_data), dataEnd(in_data + in_dataSize), prevTimestamp(0)
+        , prevAddress(0), sessionStarted(false)
+      {
+
+      }
+
+      //! Wether every record has been read
+      bool AtEnd() const
+      {
+        return data == dataEnd;
+      }
+
+      /*!
+       * Reads the next record of the trace. Session headers are skipped.
+       *
+       * \param record
+       *    Filled with the record read on success
+       *
+       * \returns
+       *    MEMERR_INVALID_FILE if the trace doesn't start with a header or
+       *    has an unknown version, MEMERR_CORRUPT_MEM if a record is cut
+       *    short or unknown, and MEMERR_INVALID_MEM once at the end.
+       */
+      MEMERR Next(MemTraceRecord &record)
+      {
+        while(data != dataEnd)
+        {
+          const uint8_t type = *data;
+
+          // A mapped trace that wasn't unmapped ends in zeroed padding,
+          // which later sessions may have been appended after
+          if(!type)
+          {
+            const uint8_t *paddingEnd = PaddingEnd();
+            if(paddingEnd)
+            {
+              data = paddingEnd;
+              if(data != dataEnd && !IsHeader(data))
+              {
+                return MEMERR_CORRUPT_MEM;
+              }
+              continue;
+            }
+          }
+
+          // A header starts a new session which the following records are
+          // relative to
+          if(type == static_cast<uint8_t>(MemTraceRecord::headerMagic[0]))
+          {
+            if(!IsHeader(data))
+            {
+              return MEMERR_INVALID_FILE;
+            }
+
+            data += headerSize;
+            prevTimestamp = 0;
+            prevAddress = 0;
+            sessionStarted = true;
+            continue;
+          }
+          if(!sessionStarted)
+          {
+            return MEMERR_INVALID_FILE;
+          }
+
+          ++data;
+          record.type = type;
+          record.msg.clear();
+
+          if(type == MemTraceRecord::textRecord)
+          {
+            uint64_t msgSize = 0;
+            if(!ReadVarint(msgSize)
+                || msgSize > static_cast<uint64_t>(dataEnd - data))
+            {
+              return MEMERR_CORRUPT_MEM;
+            }
+
+            record.msg.assign(reinterpret_cast<const char*>(data), msgSize);
+            data += msgSize;
+            return MEMERR_NO_ERR;
+          }
+          if(type > MEMCALL_MEM_LIMIT)
+          {
+            return MEMERR_CORRUPT_MEM;
+          }
+
+          uint64_t timeDelta = 0;
+          uint64_t threadId = 0;
+          uint64_t addressDelta = 0;
+          if(!ReadVarint(record.memSize) || !ReadVarint(timeDelta)
+              || !ReadVarint(threadId) || !ReadVarint(addressDelta))
+          {
+            return MEMERR_CORRUPT_MEM;
+          }
+
+          prevTimestamp += UnZigZag(timeDelta);
+          prevAddress += UnZigZag(addressDelta);
+          record.timestamp = prevTimestamp;
+          record.address = prevAddress;
+          record.threadId = static_cast<uint32_t>(threadId);
+
+          return MEMERR_NO_ERR;
+        }
+
+        return MEMERR_INVALID_MEM;
+      }
+
+    private:
+      //! Number of bytes in a session header
+      static constexpr size_t headerSize
+        = sizeof(MemTraceRecord::headerMagic) + 1;
+
+      //! Wether a session header starts at the given byte
+      bool IsHeader(const uint8_t *pos) const
+      {
+        return static_cast<size_t>(dataEnd - pos) >= headerSize
+          && std::memcmp(pos, MemTraceRecord::headerMagic
+              , sizeof(MemTraceRecord::headerMagic)) == 0
+          && pos[headerSize - 1] == MemTraceRecord::headerVersion;
+      }
+
+      /*!
+       * Gets the end of the zeroed padding starting at the current record,
+       * or nullptr if the zeros are an allocation record instead. Thread
+       * ids start at 1 so every record has a non zero byte within its first
+       * four bytes, and a longer run of zeros can only be padding. Shorter
+       * runs are padding when they end the trace or a header follows them.
+       */
+      const uint8_t *PaddingEnd() const
+      {
+        const uint8_t *byte = data;
+        while(byte != dataEnd && !*byte)
+        {
+          ++byte;
+        }
+
+        if(byte == dataEnd || byte - data >= 4 || IsHeader(byte))
+        {
+          return byte;
+        }
+
+        return nullptr;
+      }
+
+      //! Reads a varint, failing if it runs past the end of the trace
+      bool ReadVarint(uint64_t &value)
+      {
+        value = 0;
+        for(size_t shift = 0; shift < 64; shift += 7)
+        {
+          if(data == dataEnd)
+          {
+            return false;
+          }
+
+          const uint8_t byte = *data++;
+          value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+          if(!(byte & 0x80))
+          {
+            return true;
+          }
+        }
+
+        return false;
+      }
+
+      //! Reverses the zig zag mapping of a difference
+      static uint64_t UnZigZag(const uint64_t &value)
+      {
+        return (value >> 1) ^ (0 - (value & 1));
+      }
+
+      //! The next byte to read
+      const uint8_t *data;
+      //! One past the last byte of the trace
+      const uint8_t *dataEnd;
+      //! Time of the previous record
+      uint64_t prevTimestamp;
+      //! Address of the previous record
+      uint64_t prevAddress;
+      //! Wether a header has been read
+      bool sessionStarted;
+  };
+
+  /*!
+   * \class 
+   *    MemCallback
+   * \brief
+   *    A helper class that helps organize and inteperet callbacks sent
+   *    by the memory system to the desired location while returning relavent
+   *    information to the user
+   *
+   *    Operations included:
+   *
+   *
+   * \deprecated
+   *    N/A
+   *
+   * \bug
+   *    N/A
+   */
+  class MemCallback
+  {
+    public:
+      /*!
+       * Creates a new callback for memory allocation and deallocation.
+       * This can be either a general callback for all MemStax memory types
+       * or a specialized callback for a single type. Additionally the user
+       * may replace the default callback with their own callback funciton
+       * with different internal functionality (for example: if they have
+       * a sort of custom event or message handler that needs to be notified.)
+       *
+       * \param callbackFunc
+       *    A callback funciton as defined by memcallbackfunc that will recieve
+       *    messages from allocs and deallocations
+       */
+      MemCallback(MemTrace *in_traceClass = nullptr
+          , memcallbackfunc in_callback = CallbackFunc
+          , MEMERR *error = nullptr)
+        : callbackInit(false), traceClass(in_traceClass), callback(in_callback)
+      {
+        // Check for a valid callback function enabling callback funcitonality
+        // if it is
+        if(callback)
+        {
+          callbackInit = true;
+        }
+        // If not then reports an error if an error address has been given
+        else if (error)
+        {
+          *error = MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+      }
+
+      /*!
+       *
+       */
+      ~MemCallback()
+      {
+        if(callback)
+        {
+          callbackInit = false;
+        }
+      }
+
+      /*!
+       * Performs a callback but calling the classes callback funciton that
+       * the user has provided. The user is required to give a msg but can
+       * leave the size blank if they wish to ignore it and it will print
+       * out a 0 by default
+       *
+       * \param msg
+       *    The callback message being sent to the callback manager
+       * \param memSize
+       *    The size of the object being allocated into memory
+       * \param address
+       *    The address of the object if known. Only the default callback
+       *    function can trace it since it isn't given to callback functions.
+       *
+       * \returns
+       *    An error message for error checking
+       */
+      MEMERR PerformCallback(const MEMCALL &msg, const size_t &memSize = 0
+          , const void *address = nullptr)
+      {
+        if(callbackInit)
+        {
+          CountCallback(msg, memSize);
+
+          // The default callback logs the event straight to the trace so
+          // that binary traces get its address
+          if(callback == CallbackFunc)
+          {
+            if(traceClass)
+            {
+              traceClass->LogEvent(msg, memSize, address);
+            }
+            return MEMERR_NO_ERR;
+          }
+
+          return callback(msg, memSize, traceClass);
+        }
+
+        return MEMERR_UNINITALIZED;
+      }
+
+      /*!
+       * Adds up the counters of every thread's shard into a single snapshot.
+       * Counters still being updated by other threads may be partially
+       * included, so the snapshot is only exact once those threads are done.
+       *
+       * \returns
+       *    The number of allocations, deallocations, and bytes reported to
+       *    this callback.
+       */
+      MemStats GetStats() const
+      {
+        MemStats stats = {};
+        for(const StatShard &shard : statShards)
+        {
+          stats.allocs += shard.allocs.load(std::memory_order_relaxed);
+          stats.deallocs += shard.deallocs.load(std::memory_order_relaxed);
+          stats.bytesAllocated 
+            += shard.bytesAllocated.load(std::memory_order_relaxed);
+          stats.bytesDeallocated 
+            += shard.bytesDeallocated.load(std::memory_order_relaxed);
+          stats.errors += shard.errors.load(std::memory_order_relaxed);
+        }
+        stats.memInUse = stats.bytesAllocated - stats.bytesDeallocated;
+
+        return stats;
+      }
+  
+      /*!
+       * Returns a pointer to the callback function
+       */
+      memcallbackfunc GetMemCallback()
+      {
+        if(!callback)
+        {
+          // TODO: Add and replace with memory exceptions
+          return nullptr;
+        }
+
+        return callback;
+      }
+
+
+
+    private:
+      //! Size of a cache line used to keep shards from sharing lines
+      static constexpr size_t cacheLineSize = 64;
+      //! Number of shards the counters are split between
+      static constexpr size_t numOfStatShards = 16;
+
+      /*!
+       * The counters updated by a group of threads. Each shard fills its own
+       * cache line so threads counting at the same time don't false share.
+       */
+      struct alignas(cacheLineSize) StatShard
+      {
+        std::atomic<uint64_t> allocs{0};
+        std::atomic<uint64_t> deallocs{0};
+        std::atomic<uint64_t> bytesAllocated{0};
+        std::atomic<uint64_t> bytesDeallocated{0};
+        std::atomic<uint64_t> errors{0};
+      };
+
+      /*!
+       * Counts a callback message in the calling thread's shard. Threads are
+       * spread over the shards in the order they first count something.
+       */
+      void CountCallback(const MEMCALL &msg, const size_t &memSize)
+      {
+        static thread_local const size_t shardIndex 
+          = nextStatShard.fetch_add(1, std::memory_order_relaxed) 
+          % numOfStatShards;
+        StatShard &shard = statShards[shardIndex];
+
+        switch(msg)
+        {
+          case MEMCALL_ALLOC:
+            shard.allocs.fetch_add(1, std::memory_order_relaxed);
+            shard.bytesAllocated.fetch_add(memSize, std::memory_order_relaxed);
+            break;
+          case MEMCALL_DEALLOC:
+            shard.deallocs.fetch_add(1, std::memory_order_relaxed);
+            shard.bytesDeallocated.fetch_add(memSize
+                , std::memory_order_relaxed);
+            break;
+          default:
+            shard.errors.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+
+    public:
+      /*!
+       * The default callback function which sends a message describing the
+       * callback to the given trace if there is one.
+       *
+       * \param msg
+       *    The callback message being described
+       * \param memSize
+       *    The size of the memory the message is about
+       * \param traceCall
+       *    The trace the message is logged to. Nothing is logged if nullptr
+       *
+       * \returns
+       *    An error message for error checking
+       */
+      static MEMERR CallbackFunc(const MEMCALL &msg, const size_t &memSize
+          , MemTrace *traceCall)
+      {
+        // Skip formatting a message that nobody is going to read
+        if(!traceCall)
+        {
+          return MEMERR_NO_ERR;
+        }
+
+        // Give the trace log the callbacks message
+        traceCall->LogEvent(msg, memSize);
+
+        return MEMERR_NO_ERR;
+      }
+
+    private:
+      //! Hands out shards to threads as they first count a callback
+      static inline std::atomic<size_t> nextStatShard{0};
+
+      //! Per thread shards of the callback counters
+      StatShard statShards[numOfStatShards];
+      bool callbackInit;
+      MemTrace *traceClass;
+      memcallbackfunc callback;
+  };
+
+  /*!
+   * \class MemCallbackPolicy
+   * \brief
+   *    The default callback policy of a heap which forwards every message to
+   *    the MemCallback given on initalization. Allocation and deallocation
+   *    messages are skipped when MEMFLAGS_DISABLE_DEBUG_MSG is set.
+   *
+   *    A callback policy decides at compile time what a heap does with its
+   *    callback messages. Every policy provides:
+   *    - MEMERR Initalize(MemCallback *, const uint8_t &memFlags)
+   *    - void Terminate()
+   *    - MEMERR Notify(const MEMCALL &, const size_t &memSize
+   *        , const void *address)
+   *
+   * \deprecated
+   *    N/A
+   *
+   * \bug
+   *    N/A
+   */
+  class MemCallbackPolicy
+  {
+    public:
+      MemCallbackPolicy()
+        : callbackClass(nullptr), debugMsgs(false)
+      {
+
+      }
+
+      //! Stores the callback of the heap being initalized
+      MEMERR Initalize(MemCallback *in_callbackClass, const uint8_t &memFlags)
+      {
+        callbackClass = in_callbackClass;
+        debugMsgs = !(memFlags & MEMFLAGS_DISABLE_DEBUG_MSG);
+
+        return MEMERR_NO_ERR;
+      }
+
+      //! Removes access to the callback once the heap is terminated
+      void Terminate()
+      {
+        callbackClass = nullptr;
+      }
+
+      //! Sends the message to the callback if there is one
+      MEMERR Notify(const MEMCALL &msg, const size_t &memSize
+          , const void *address = nullptr)
+      {
+        if(!callbackClass)
+        {
+          return MEMERR_NO_ERR;
+        }
+
+        // Allocations and deallocations are debug messages
+        if(!debugMsgs && (msg == MEMCALL_ALLOC || msg == MEMCALL_DEALLOC))
+        {
+          return MEMERR_NO_ERR;
+        }
+
+        return callbackClass->PerformCallback(msg, memSize, address);
+      }
+
+    private:
+      //! The callback given on initalization
+      MemCallback *callbackClass;
+      //! Wether allocation and deallocation messages are sent
+      bool debugMsgs;
+  };
+
+  /*!
+   * A callback policy that ignores every message so that a heap's callbacks
+   * compile down to nothing.
+   */
+  class NullPolicy
+  {
+    public:
+      MEMERR Initalize(MemCallback *, const uint8_t &)
+      {
+        return MEMERR_NO_ERR;
+      }
+
+      void Terminate()
+      {
+
+      }
+
+      MEMERR Notify(const MEMCALL &, const size_t &, const void * = nullptr)
+      {
+        return MEMERR_NO_ERR;
+      }
+  };
+
+  /*!
+   * A callback policy that only counts messages within the heap so that an
+   * allocation costs a couple of adds. The counters are plain integers
+   * unless atomicCounts is set, which is required by thread safe heaps.
+   */
+  template<bool atomicCounts = false>
+  class CountingPolicy
+  {
+    public:
+      //! Thread safe heaps would race on plain counters
+      MEMERR Initalize(MemCallback *, const uint8_t &memFlags)
+      {
+        if(!atomicCounts && (memFlags & MEMFLAGS_THREAD_SAFE))
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      void Terminate()
+      {
+
+      }
+
+      //! Counts the message
+      MEMERR Notify(const MEMCALL &msg, const size_t &memSize
+          , const void * = nullptr)
+      {
+        switch(msg)
+        {
+          case MEMCALL_ALLOC:
+            Add(allocs, 1);
+            Add(bytesAllocated, memSize);
+            break;
+          case MEMCALL_DEALLOC:
+            Add(deallocs, 1);
+            Add(bytesDeallocated, memSize);
+            break;
+          default:
+            Add(errors, 1);
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      //! Gets a snapshot of the counters
+      MemStats GetStats() const
+      {
+        MemStats stats = {};
+        stats.allocs = allocs;
+        stats.deallocs = deallocs;
+        stats.bytesAllocated = bytesAllocated;
+        stats.bytesDeallocated = bytesDeallocated;
+        stats.memInUse = stats.bytesAllocated - stats.bytesDeallocated;
+        stats.errors = errors;
+
+        return stats;
+      }
+
+    private:
+      using Counter = std::conditional_t<atomicCounts
+        , std::atomic<uint64_t>, uint64_t>;
+
+      static void Add(Counter &counter, const uint64_t &amount)
+      {
+        if constexpr(atomicCounts)
+        {
+          counter.fetch_add(amount, std::memory_order_relaxed);
+        }
+        else
+        {
+          counter += amount;
+        }
+      }
+
+      Counter allocs{0};
+      Counter deallocs{0};
+      Counter bytesAllocated{0};
+      Counter bytesDeallocated{0};
+      Counter errors{0};
+  };
+
+  /*!
+   * A callback policy that logs every message straight to a MemTrace given
+   * with SetTrace without going through a MemCallback. Allocation and
+   * deallocation messages are skipped when MEMFLAGS_DISABLE_DEBUG_MSG is set.
+   */
+  class TracingPolicy
+  {
+    public:
+      TracingPolicy()
+        : trace(nullptr), debugMsgs(false)
+      {
+
+      }
+
+      MEMERR Initalize(MemCallback *, const uint8_t &memFlags)
+      {
+        debugMsgs = !(memFlags & MEMFLAGS_DISABLE_DEBUG_MSG);
+
+        return MEMERR_NO_ERR;
+      }
+
+      void Terminate()
+      {
+
+      }
+
+      //! Logs the message to the trace if there is one
+      MEMERR Notify(const MEMCALL &msg, const size_t &memSize
+          , const void *address = nullptr)
+      {
+        if(!trace
+            || (!debugMsgs && (msg == MEMCALL_ALLOC || msg == MEMCALL_DEALLOC)))
+        {
+          return MEMERR_NO_ERR;
+        }
+
+        return trace->LogEvent(msg, memSize, address);
+      }
+
+      //! Sets the trace that messages are logged to
+      void SetTrace(MemTrace *in_trace)
+      {
+        trace = in_trace;
+      }
+
+    private:
+      //! The trace messages are logged to
+      MemTrace *trace;
+      //! Wether allocation and deallocation messages are logged
+      bool debugMsgs;
+  };
+
+  /*!
+   * Creates raw memory in the heap that is not directly handled by the class
+   *
+   * with default allocation space of 1024 bytes for objects allocated
+   *
+   * The heap is templated on a callback policy which is given every message
+   * the heap sends. MemHeap uses MemCallbackPolicy, while NullPolicy lets
+   * the callbacks be removed from the allocation path entirely.
+   */
+  template<typename Policy>
+  class BasicMemHeap
+  {
+    public:
+      BasicMemHeap()
+        : heapInitalized(false), memFlags(0)
+        , numOfPages(0), pageCapacity(0), pageSizes(nullptr), pages(nullptr)
+        , numOfClasses(0), freeLists(nullptr), freeSpaceMap(0)
+        , nextInBucket(nullptr), prevInBucket(nullptr)
+        , softMemBudget(0), hardMemBudget(0), memReserved(0)
+        , largePages(nullptr), numOfLargePages(0), largePageCapacity(0)
+        , activePage(0), destructors(nullptr), numOfDestructors(0)
+        , destructorCapacity(0), pageHeaderSize(0), heapId(0)
+        , threadCaches(nullptr), nextLiveHeap(nullptr), emptySlabs(nullptr)
+        , numOfSlabClasses(0), buddyOrderMap(0), buddyMinOrder(0)
+        , buddyMaxOrder(0), buddyWords(0), buddyHeaderSize(0)
+      {
+
+      }
+      ~BasicMemHeap()
+      {
+        // Release all pages if the user hasn't terminated the heap
+        TerminateHeapMem();
+      }
+
+      // Default vairables as static consts
+      static inline const size_t defaultPageSize = 1024;
+      static inline const size_t defaultNumOfPages = 10;
+      static inline const size_t defaultAllignment = 8;
+
+      // The callback given is handed to the heap's callback policy which may
+      // ignore it, as NullPolicy and CountingPolicy do.
+      //
+      // The number of pages given is only the starting capacity of the page
+      // directory which grows geometrically as pages are needed. Use
+      // SetMemBudget to limit how much memory the heap may reserve.
+      //
+      // Passing MEMFLAGS_MONOTONIC turns the heap into an arena that only
+      // bumps forward. Deallocate no longer returns memory and everything
+      // is instead released at once with RewindTo or Reset.
+      //
+      // Passing MEMFLAGS_THREAD_SAFE lets the heap be shared between 
+      // threads. Each thread keeps a small cache of free blocks for every
+      // size class and only locks the heap to refill or flush its cache in
+      // batches. Initalizing and terminating the heap are not thread safe.
+      // Each thread also owns a page that it bumps from without locking. 
+      // Blocks freed by another thread are pushed onto the owner's lock free
+      // remote free list which the owner drains on its next allocation. The
+      // page size of a thread safe heap must be a power of two.
+      //
+      // Passing MEMFLAGS_SLAB turns each page into a slab of equal sized
+      // slots for a single size class, with a bitmap marking which slots are
+      // in use. Objects of a class are packed densely together, a slab that
+      // empties goes back to a pool of pages any class can reuse unless it
+      // is the last its class has, and ForEachLiveBlock walks every live
+      // block. The page size of a slab heap must be a power of two and it
+      // can't be monotonic or thread safe.
+      //
+      // Passing MEMFLAGS_BUDDY turns each page into a region split into 
+      // power of two blocks by a buddy allocator, so a single large page 
+      // serves sizes from a few bytes up to half the page. Freed blocks 
+      // merge with their buddy whenever it is free as well, bounding 
+      // fragmentation for mixed sizes. The page size of a buddy heap must be
+      // a power of two and it can't be monotonic, thread safe, or a slab
+      // heap.
+      MEMERR InitalizeHeapMem(const size_t &in_pageSize = defaultPageSize 
+          , const size_t &in_numOfPages = defaultNumOfPages
+          , const size_t &in_allignment = defaultAllignment
+          , MemCallback *callbackClass = nullptr
+          , const uint8_t &in_memFlags = MEMFLAGS_NONE)
+      {
+        // Create an error tracking object
+        MEMERR error = MEMERR_NO_ERR;
+
+        // Release any memory from a previous initalization
+        TerminateHeapMem();
+
+        // Initalize all objects for the page
+        // Set number of pages to 0 to make sure it is initalized
+        numOfPages = 0;
+        activePage = 0;
+        memReserved = 0;
+        memFlags = in_memFlags;
+        // Update the page size and the starting page directory capacity
+        maxPageSize = in_pageSize;
+        pageCapacity = (in_numOfPages > 1) ? in_numOfPages : 1;
+        // Update the allignment of each object
+        allignment = in_allignment;
+
+        // Bump allocation relies on the allignment being a power of two
+        if(!IsPowerOfTwo(allignment))
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        // Monotonic heaps rewind every thread's allocations at once so they
+        // can't be shared between threads
+        if((memFlags & MEMFLAGS_MONOTONIC) && (memFlags & MEMFLAGS_THREAD_SAFE))
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        // Size classes are spaced by the allignment but must be able to hold
+        // a free list link once a block has been returned to the heap
+        classGranularity = (allignment > sizeof(void*)) 
+          ? allignment : sizeof(void*);
+        numOfClasses = maxPageSize / classGranularity;
+
+        // Make sure at least one size class fits within a page
+        if(!numOfClasses)
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        // Pages of thread safe heaps start with a header naming their owner
+        // which is found by alligning a block's address down to its page
+        pageHeaderSize = 0;
+        if(memFlags & MEMFLAGS_THREAD_SAFE)
+        {
+          pageHeaderSize = (sizeof(PageHeader) + classGranularity - 1)
+            & ~(classGranularity - 1);
+          if(!IsPowerOfTwo(maxPageSize) || maxPageSize <= pageHeaderSize)
+          {
+            return MEMERR_INVALID_FUNCTION_PARAMETER;
+          }
+        }
+
+        // Slab pages start with a header found by alligning a block's
+        // address down to its page so they must hold at least one slot.
+        // Classes are placed in slabs up to the first that has no room.
+        emptySlabs = nullptr;
+        numOfSlabClasses = 0;
+        if(memFlags & MEMFLAGS_SLAB)
+        {
+          size_t numOfSlots = 1;
+          size_t numOfWords = 0;
+          size_t slotsOffset = 0;
+          while(numOfSlots && numOfSlabClasses < numOfClasses)
+          {
+            SlabLayout(numOfSlabClasses, numOfSlots, numOfWords, slotsOffset);
+            numOfSlabClasses += numOfSlots ? 1 : 0;
+          }
+          if((memFlags & (MEMFLAGS_MONOTONIC | MEMFLAGS_THREAD_SAFE))
+              || !IsPowerOfTwo(maxPageSize) || !numOfSlabClasses)
+          {
+            return MEMERR_INVALID_FUNCTION_PARAMETER;
+          }
+        }
+
+        // Buddy pages start with the free and allocated bitmaps of every
+        // order, rounded up to the smallest block so blocks stay alligned
+        buddyOrderMap = 0;
+        if(memFlags & MEMFLAGS_BUDDY)
+        {
+          if((memFlags & (MEMFLAGS_MONOTONIC | MEMFLAGS_THREAD_SAFE 
+                  | MEMFLAGS_SLAB)) || !IsPowerOfTwo(maxPageSize))
+          {
+            return MEMERR_INVALID_FUNCTION_PARAMETER;
+          }
+
+          // The smallest block must hold the links of a free block
+          buddyMinOrder = FloorLog2((classGranularity > 2 * sizeof(void*))
+              ? classGranularity : 2 * sizeof(void*));
+          const size_t pageOrder = FloorLog2(maxPageSize);
+          if(pageOrder <= buddyMinOrder)
+          {
+            return MEMERR_INVALID_FUNCTION_PARAMETER;
+          }
+          buddyWords = (BuddyBitBase(pageOrder + 1) + 63) / 64;
+          const size_t minBlockSize = size_t(1) << buddyMinOrder;
+          buddyHeaderSize = (2 * buddyWords * sizeof(uint64_t) 
+              + minBlockSize - 1) & ~(minBlockSize - 1);
+          if(buddyHeaderSize >= maxPageSize)
+          {
+            return MEMERR_INVALID_FUNCTION_PARAMETER;
+          }
+
+          // The block ending the page is the largest left after the header
+          buddyMaxOrder = buddyMinOrder;
+          for(size_t offset = buddyHeaderSize; offset < maxPageSize
+              ; offset += size_t(1) << LowestBit(offset))
+          {
+            buddyMaxOrder = LowestBit(offset);
+          }
+        }
+
+        // Hand the callback to the policy which may reject the flags given
+        error = policy.Initalize(callbackClass, memFlags);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Allocate the page directory
+        error = AllocatePageDirectory(pages, pageSizes, nextInBucket
+            , prevInBucket, pageCapacity);
+
+        // Allocate the free list heads for each size class
+        if(error == MEMERR_NO_ERR)
+        {
+          error = TryAllocate<void*>(freeLists, numOfClasses);
+        }
+
+        // Set every free list to empty
+        for(size_t i = 0; error == MEMERR_NO_ERR && i < numOfClasses; ++i)
+        {
+          freeLists[i] = nullptr;
+        }
+
+        // Empty every free space bucket
+        freeSpaceMap = 0;
+        for(size_t i = 0; i < numOfBuckets; ++i)
+        {
+          bucketHeads[i] = noPage;
+        }
+
+        // Return the error if something failed
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Allocate the first page
+        error = AllocatePage();
+
+        // Return the error if something failed
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+        
+        // Give the heap a new id so thread caches of a previous 
+        // initalization are never mistaken for this one's
+        heapId = nextHeapId.fetch_add(1, std::memory_order_relaxed);
+
+        // Let exiting threads find the heap to return their caches to
+        if(memFlags & MEMFLAGS_THREAD_SAFE)
+        {
+          std::lock_guard<std::mutex> liveLock(liveHeapsMutex);
+          nextLiveHeap = liveHeaps;
+          liveHeaps = this;
+        }
+        
+        // Turn on the heap to enable allocation
+        heapInitalized = true;
+
+        return MEMERR_NO_ERR;
+      }
+
+      MEMERR TerminateHeapMem()
+      {
+        // Stop exiting threads from returning their caches to the heap
+        if(heapInitalized && (memFlags & MEMFLAGS_THREAD_SAFE))
+        {
+          std::lock_guard<std::mutex> liveLock(liveHeapsMutex);
+          BasicMemHeap **p_link = &liveHeaps;
+          while(*p_link != this)
+          {
+            p_link = &(*p_link)->nextLiveHeap;
+          }
+          *p_link = nextLiveHeap;
+        }
+
+        // Release every thread cache since the blocks they hold live within
+        // the pages
+        while(threadCaches)
+        {
+          ThreadCache *cache = threadCaches;
+          threadCaches = cache->nextCache;
+          ReleaseThreadCache(cache);
+        }
+
+        // Turn off the heap
+        heapInitalized = false;
+
+        // Remove access to the callback
+        policy.Terminate();
+
+        // Release the free list heads since every block they point to lives
+        // within a page
+        if(freeLists)
+        {
+          ReleaseArray<void*>(freeLists, numOfClasses);
+        }
+
+        // Run any destructors a monotonic heap is still tracking
+        RunDestructors(0);
+        if(destructors)
+        {
+          ReleaseArray<DestructorEntry>(destructors, destructorCapacity);
+        }
+        destructorCapacity = 0;
+
+        // Release every large page along with its directory
+        ReleaseLargePages();
+
+        // Release every page along with the page directory
+        for(size_t i = 0; pages && i < numOfPages; ++i)
+        {
+          ReleasePageMem(pages[i]);
+        }
+        ReleasePageDirectory(pages, pageSizes, nextInBucket, prevInBucket
+            , pageCapacity);
+        numOfPages = 0;
+        activePage = 0;
+        pageCapacity = 0;
+        memReserved = 0;
+        freeSpaceMap = 0;
+        emptySlabs = nullptr;
+        buddyOrderMap = 0;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Sets how many bytes of pages the heap may reserve. Going over the
+       * soft budget still allocates the page but notifies the callback
+       * while the hard budget causes allocations to fail with an out of
+       * memory error. A budget of 0 means there is no limit.
+       *
+       * \param in_softBudget
+       *    The number of bytes after which the callback is notified
+       * \param in_hardBudget
+       *    The number of bytes the heap can never reserve more than
+       *
+       * \returns
+       *    A memory error result
+       */
+      MEMERR SetMemBudget(const size_t &in_softBudget
+          , const size_t &in_hardBudget = 0)
+      {
+        // A soft budget above the hard budget could never be reached
+        if(in_hardBudget && in_softBudget > in_hardBudget)
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        softMemBudget = in_softBudget;
+        hardMemBudget = in_hardBudget;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Gets the number of bytes currently reserved by the heap's pages.
+       */
+      size_t GetMemReserved() const
+      {
+        std::unique_lock<std::mutex> lock = LockHeap();
+        return memReserved;
+      }
+
+      /*!
+       * Gets the heap's callback policy, such as to read the counters of a
+       * CountingPolicy or give a TracingPolicy its trace.
+       */
+      Policy &GetPolicy()
+      {
+        return policy;
+      }
+
+      /*!
+       * A position within a monotonic heap that it can be rewound to.
+       */
+      struct MemMarker
+      {
+        //! The page being bumped from when the marker was taken
+        size_t page;
+        //! The bytes used within that page when the marker was taken
+        size_t pageSize;
+        //! The number of large pages when the marker was taken
+        size_t numOfLargePages;
+        //! The number of tracked destructors when the marker was taken
+        size_t numOfDestructors;
+      };
+
+      /*!
+       * Gets a marker for the current position of a monotonic heap.
+       */
+      MemMarker GetMarker() const
+      {
+        return { activePage, pageSizes ? pageSizes[activePage] : 0
+          , numOfLargePages, numOfDestructors };
+      }
+
+      /*!
+       * Rewinds a monotonic heap back to a marker, releasing everything
+       * allocated since the marker was taken in one step. Only the pages
+       * bumped since the marker are touched and tracked destructors are run
+       * in reverse order of allocation.
+       *
+       * \param marker
+       *    A marker taken from this heap that hasn't been rewound past
+       *
+       * \returns
+       *    A memory error result
+       */
+      MEMERR RewindTo(const MemMarker &marker)
+      {
+        // Only monotonic heaps can be rewound
+        if(!heapInitalized)
+        {
+          return MEMERR_UNINITALIZED;
+        }
+        if(!(memFlags & MEMFLAGS_MONOTONIC))
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        // Make sure the marker isn't ahead of the heap
+        if(marker.page > activePage || marker.numOfLargePages > numOfLargePages
+            || marker.numOfDestructors > numOfDestructors
+            || (marker.page == activePage 
+              && marker.pageSize > pageSizes[activePage]))
+        {
+          return MEMERR_INVALID_MEM;
+        }
+
+        // Destroy tracked objects before their memory is given back
+        RunDestructors(marker.numOfDestructors);
+
+        // Release large pages from newest to oldest
+        while(numOfLargePages > marker.numOfLargePages)
+        {
+          const LargePage &page = largePages[--numOfLargePages];
+          memReserved -= page.memSize;
+          ::operator delete(page.mem, std::align_val_t(page.memAllignment));
+        }
+
+        // Empty every page bumped since the marker
+        for(size_t i = marker.page + 1; i <= activePage; ++i)
+        {
+          pageSizes[i] = 0;
+        }
+        pageSizes[marker.page] = marker.pageSize;
+        activePage = marker.page;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Releases everything allocated from a monotonic heap while keeping 
+       * its pages for reuse.
+       */
+      MEMERR Reset()
+      {
+        return RewindTo({ 0, 0, 0, 0 });
+      }
+
+      /*!
+       * Takes in a pointer and creates a raw pointer that is returned
+       * to the user to be handled. Additionally keeps track of allocs and
+       * double allocation and returns errors properly in case an issue
+       * occurs.
+       *
+       * \param p_Obj
+       *  A pointer that will be filled with a new obj allocated on success
+       * \param callbackFun
+       *  A pointer to a callback function that is not required but will
+       *  send a message to the given callback func if provided. Callback
+       *  may keep track of allcoations as well but class will continue
+       *  to keep personal count.
+       *
+       * An example of the callback funciton as it will be taken by 
+       * the function.
+       *
+       * TODO: PROVIDE BETTER EXAMPLE
+       *  void (*)(const std::string &string)
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       *  which helps the use avoid doing unnecessary error checking
+       *  and bloating their own code/program.
+       */
+      template<typename T>
+      MEMERR Allocate(T *&p_Obj)
+      { 
+        return Allocate<T>(p_Obj, alignof(T));
+      }
+
+      /*!
+       * Allocates an object the same way as Allocate but places it at an
+       * address that is a multiple of the given allignment. Used for types
+       * such as SIMD vectors that need 32 or 64 byte allignment.
+       *
+       * \param p_Obj
+       *  A pointer that will be filled with a new obj allocated on success
+       * \param in_allignment
+       *  The allignment of the object which must be a power of two. The
+       *  heap's allignment and the type's own allignment are still honored
+       *  if they are larger.
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       */
+      template<typename T>
+      MEMERR Allocate(T *&p_Obj, const size_t &in_allignment)
+      { 
+        // Find an alligned block within a page to hold the object
+        void *block = nullptr;
+        MEMERR error = BeginAllocate(p_Obj, sizeof(T), in_allignment, block);
+
+        // Check to see if there was an error and return if there was
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Attempt to allocate the object into the block
+        error = TryAllocate<T>(p_Obj, 1, block);
+
+        // Return the block to its free list if construction failed
+        if(error != MEMERR_NO_ERR)
+        {
+          FreeBlock(block, SizeClassIndex(sizeof(T)));
+          return error;
+        }
+
+        // Let a monotonic heap destroy the object when it is rewound
+        error = TrackDestructor(p_Obj, 1);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        return EndAllocate(sizeof(T), p_Obj);
+      }
+
+      /*!
+       * Allocates an object by constructing it directly within its page slot
+       * with the given constructor arguments. This avoids default 
+       * constructing the object and then assigning over it.
+       *
+       * \param p_Obj
+       *  A pointer that will be filled with a new obj allocated on success
+       * \param args
+       *  The arguments forwarded to the object's constructor
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       */
+      template<typename T, typename... Args>
+      MEMERR Emplace(T *&p_Obj, Args&&... args)
+      {
+        // Find an alligned block within a page to hold the object
+        void *block = nullptr;
+        MEMERR error = BeginAllocate(p_Obj, sizeof(T), alignof(T), block);
+
+        // Check to see if there was an error and return if there was
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Attempt to construct the object within the block
+        error = TryEmplace<T>(p_Obj, block, std::forward<Args>(args)...);
+
+        // Return the block to its free list if construction failed
+        if(error != MEMERR_NO_ERR)
+        {
+          FreeBlock(block, SizeClassIndex(sizeof(T)));
+          return error;
+        }
+
+        // Let a monotonic heap destroy the object when it is rewound
+        error = TrackDestructor(p_Obj, 1);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        return EndAllocate(sizeof(T), p_Obj);
+      }
+
+      /*!
+       * Allocates space for an object without constructing it at all. Only
+       * usable with trivially constructible types which are expected to be
+       * written by the user before they are read.
+       *
+       * \param p_Obj
+       *  A pointer that will be filled with the uninitalized object
+       * \param in_allignment
+       *  The allignment of the object which must be a power of two
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       */
+      template<typename T>
+      MEMERR AllocateUninitalized(T *&p_Obj
+          , const size_t &in_allignment = alignof(T))
+      {
+        static_assert(std::is_trivially_default_constructible<T>::value
+            , "AllocateUninitalized requires a trivially constructible type");
+
+        // Find an alligned block within a page to hold the object
+        void *block = nullptr;
+        MEMERR error = BeginAllocate(p_Obj, sizeof(T), in_allignment, block);
+
+        // Check to see if there was an error and return if there was
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Hand the block out as is
+        p_Obj = static_cast<T*>(block);
+
+        return EndAllocate(sizeof(T), p_Obj);
+      }
+
+      /*!
+       * Destroys an object that was allocated by the heap and returns its
+       * block to the free list of its size class so the next allocation of
+       * the same class reuses it. Both pushing and popping a free list are
+       * constant time.
+       *
+       * \param p_Obj
+       *  A pointer to an object allocated by this heap. Set to nullptr once
+       *  the object has been deallocated.
+       *
+       * \returns
+       *  A MEMERR indicating if any errors occured during deallocation
+       */
+      template<typename T>
+      MEMERR Deallocate(T *&p_Obj)
+      {
+        // Initalize to avoid a non-error passing an error
+        MEMERR error = MEMERR_NO_ERR;
+
+        if(!p_Obj)
+        {
+
+          // If there was an error with calling new then call the callback
+          // funciton if avaliable to print a message then return
+          // an out of mem error to the user so they are able to respond
+          // appropriatly
+          error = policy.Notify(MEMCALL_INVALID_MEM, sizeof(T));
+
+          // Make sure no errors occured during callback... 
+          // if there was an error then return the error to user :)
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+
+          return MEMERR_INVALID_MEM;
+        }
+
+        // If there is a callback and debug messages are on
+        // then perform a callback message
+        error = policy.Notify(MEMCALL_DEALLOC, sizeof(T), p_Obj);
+
+        // A monotonic heap only gives memory back when it is rewound so the
+        // object is destroyed unless the rewind is going to destroy it
+        if(memFlags & MEMFLAGS_MONOTONIC)
+        {
+          if(!(memFlags & MEMFLAGS_TRACK_DESTRUCTORS))
+          {
+            p_Obj->~T();
+          }
+          p_Obj = nullptr;
+
+          return MEMERR_NO_ERR;
+        }
+
+        // Destroy the object in place since its memory belongs to a page
+        p_Obj->~T();
+
+        // Return the block to the free list of its size class
+        FreeBlock(p_Obj, SizeClassIndex(sizeof(T)));
+        p_Obj = nullptr;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Allocates a contiguous array of objects. Arrays that fit within a
+       * page are carved out of one like any other block while larger arrays
+       * are given a dedicated large page of their own. Trivially 
+       * constructible types are zeroed in bulk instead of being constructed
+       * one at a time.
+       *
+       * \param p_Arr
+       *  A pointer that will be filled with the first object of the array
+       * \param count
+       *  The number of objects in the array
+       * \param in_allignment
+       *  The allignment of the array which must be a power of two
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       */
+      template<typename T>
+      MEMERR AllocateArray(T *&p_Arr, const size_t &count
+          , const size_t &in_allignment = alignof(T))
+      {
+        // Find a span large enough to hold every object
+        void *span = nullptr;
+        MEMERR error = BeginAllocateArray(p_Arr, sizeof(T), count
+            , in_allignment, span);
+
+        // Check to see if there was an error and return if there was
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Zero trivial types in one pass since they need no constructor
+        if constexpr(std::is_trivially_default_constructible<T>::value)
+        {
+          std::memset(span, 0, sizeof(T) * count);
+          p_Arr = static_cast<T*>(span);
+        }
+        // Otherwise construct each object in place
+        else
+        {
+          T *first = static_cast<T*>(span);
+          for(size_t i = 0; i < count; ++i)
+          {
+            T *p_elem = nullptr;
+            error = TryAllocate<T>(p_elem, 1, first + i);
+
+            // Destroy what has been constructed and give back the span
+            if(error != MEMERR_NO_ERR)
+            {
+              DestroyArray(first, i);
+              ReleaseSpan(span, sizeof(T), count, in_allignment);
+              return error;
+            }
+          }
+          p_Arr = first;
+
+          // Let a monotonic heap destroy the array when it is rewound
+          error = TrackDestructor(p_Arr, count);
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+        }
+
+        return EndAllocate(sizeof(T) * count, p_Arr);
+      }
+
+      /*!
+       * Allocates a contiguous array without constructing or zeroing it. 
+       * Only usable with trivially constructible types.
+       *
+       * \param p_Arr
+       *  A pointer that will be filled with the first object of the array
+       * \param count
+       *  The number of objects in the array
+       * \param in_allignment
+       *  The allignment of the array which must be a power of two
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       */
+      template<typename T>
+      MEMERR AllocateArrayUninitalized(T *&p_Arr, const size_t &count
+          , const size_t &in_allignment = alignof(T))
+      {
+        static_assert(std::is_trivially_default_constructible<T>::value
+            , "AllocateArrayUninitalized requires a trivially constructible type");
+
+        // Find a span large enough to hold every object
+        void *span = nullptr;
+        MEMERR error = BeginAllocateArray(p_Arr, sizeof(T), count
+            , in_allignment, span);
+
+        // Check to see if there was an error and return if there was
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Hand the span out as is
+        p_Arr = static_cast<T*>(span);
+
+        return EndAllocate(sizeof(T) * count, p_Arr);
+      }
+
+      /*!
+       * Destroys every object of an array allocated by AllocateArray and
+       * returns its span to the heap. The count and allignment must match
+       * what the array was allocated with.
+       *
+       * \param p_Arr
+       *  A pointer to the first object of the array. Set to nullptr once
+       *  the array has been deallocated.
+       * \param count
+       *  The number of objects in the array
+       * \param in_allignment
+       *  The allignment the array was allocated with
+       *
+       * \returns
+       *  A MEMERR indicating if any errors occured during deallocation
+       */
+      template<typename T>
+      MEMERR DeallocateArray(T *&p_Arr, const size_t &count
+          , const size_t &in_allignment = alignof(T))
+      {
+        // Make sure there is an array to deallocate
+        if(!p_Arr || !count)
+        {
+          const MEMERR error = policy.Notify(MEMCALL_INVALID_MEM
+              , sizeof(T) * count);
+
+          return (error != MEMERR_NO_ERR) ? error : MEMERR_INVALID_MEM;
+        }
+
+        // If there is a callback and debug messages are on
+        // then perform a callback message
+        policy.Notify(MEMCALL_DEALLOC, sizeof(T) * count, p_Arr);
+
+        // A monotonic heap only gives memory back when it is rewound so the
+        // array is destroyed unless the rewind is going to destroy it
+        if(memFlags & MEMFLAGS_MONOTONIC)
+        {
+          if(!(memFlags & MEMFLAGS_TRACK_DESTRUCTORS))
+          {
+            DestroyArray(p_Arr, count);
+          }
+          p_Arr = nullptr;
+
+          return MEMERR_NO_ERR;
+        }
+
+        // Destroy every object and give the span back
+        DestroyArray(p_Arr, count);
+        ReleaseSpan(p_Arr, sizeof(T), count, in_allignment);
+        p_Arr = nullptr;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Allocates untyped memory for allocator adapters such as 
+       * MemHeapResource and Allocator. Sizes that fit within a page are
+       * served by their size class like any other block while larger sizes
+       * are given a large page. Zero bytes still allocates a unique block.
+       *
+       * \param p_Mem
+       *  A pointer that will be filled with the memory allocated
+       * \param memSize
+       *  The number of bytes to allocate
+       * \param in_allignment
+       *  The allignment of the memory which must be a power of two
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       */
+      MEMERR AllocateBytes(void *&p_Mem, const size_t &memSize
+          , const size_t &in_allignment = alignof(std::max_align_t))
+      {
+        const size_t byteCount = memSize ? memSize : 1;
+
+        // Bytes are placed the same way as an array of bytes
+        void *span = nullptr;
+        MEMERR error = BeginAllocateArray(p_Mem, 1, byteCount, in_allignment
+            , span);
+
+        // Check to see if there was an error and return if there was
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        p_Mem = span;
+
+        return EndAllocate(byteCount, p_Mem);
+      }
+
+      /*!
+       * Returns memory allocated by AllocateBytes to the heap. The size and
+       * allignment must match what the memory was allocated with.
+       *
+       * \param p_Mem
+       *  The memory to deallocate. Set to nullptr once deallocated.
+       * \param memSize
+       *  The number of bytes the memory was allocated with
+       * \param in_allignment
+       *  The allignment the memory was allocated with
+       *
+       * \returns
+       *  A MEMERR indicating if any errors occured during deallocation
+       */
+      MEMERR DeallocateBytes(void *&p_Mem, const size_t &memSize
+          , const size_t &in_allignment = alignof(std::max_align_t))
+      {
+        const size_t byteCount = memSize ? memSize : 1;
+
+        // Make sure there is memory to deallocate
+        if(!p_Mem)
+        {
+          const MEMERR error = policy.Notify(MEMCALL_INVALID_MEM, byteCount);
+
+          return (error != MEMERR_NO_ERR) ? error : MEMERR_INVALID_MEM;
+        }
+
+        // If there is a callback and debug messages are on
+        // then perform a callback message
+        policy.Notify(MEMCALL_DEALLOC, byteCount, p_Mem);
+
+        // Monotonic heaps only give memory back when they are rewound
+        if(!(memFlags & MEMFLAGS_MONOTONIC))
+        {
+          ReleaseSpan(p_Mem, 1, byteCount, in_allignment);
+        }
+        p_Mem = nullptr;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Calls the given function with every block in use within the slabs
+       * of a slab heap, visiting slabs in page order and blocks in address
+       * order within each slab. Arrays too large for a page live in large
+       * pages and are not visited. Blocks must not be allocated or 
+       * deallocated while walking.
+       *
+       * \param func
+       *    Called as func(void *block, const size_t &slotSize)
+       *
+       * \returns
+       *    A memory error result. Fails if the heap isn't a slab heap.
+       */
+      template<typename Func>
+      MEMERR ForEachLiveBlock(Func &&func) const
+      {
+        if(!heapInitalized)
+        {
+          return MEMERR_UNINITALIZED;
+        }
+        if(!(memFlags & MEMFLAGS_SLAB))
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        for(size_t i = 0; i < numOfPages; ++i)
+        {
+          const SlabHeader *slab = reinterpret_cast<SlabHeader*>(pages[i]);
+          if(!slab->numOfUsed)
+          {
+            continue;
+          }
+
+          // Visit each set bit from lowest to highest
+          uint8_t *slots = pages[i] + slab->slotsOffset;
+          for(size_t word = 0; word < slab->numOfWords; ++word)
+          {
+            uint64_t live = SlabLiveBits(slab, word);
+            while(live)
+            {
+              const size_t slot = word * 64 + LowestBit(live);
+              live &= live - 1;
+              func(static_cast<void*>(slots + slot * slab->slotSize)
+                  , slab->slotSize);
+            }
+          }
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Counts the blocks in use within the slabs of a slab heap from their
+       * occupancy bitmaps. Returns 0 for any other heap.
+       */
+      size_t CountLiveBlocks() const
+      {
+        if(!heapInitalized || !(memFlags & MEMFLAGS_SLAB))
+        {
+          return 0;
+        }
+
+        size_t numOfLive = 0;
+        for(size_t i = 0; i < numOfPages; ++i)
+        {
+          const SlabHeader *slab = reinterpret_cast<SlabHeader*>(pages[i]);
+          for(size_t word = 0; slab->numOfUsed && word < slab->numOfWords; ++word)
+          {
+            numOfLive += PopCount(SlabLiveBits(slab, word));
+          }
+        }
+
+        return numOfLive;
+      }
+
+    private:
+      bool heapInitalized;
+      uint8_t memFlags;
+      //! Receives every callback message the heap sends
+      Policy policy;
+      size_t allignment;
+      size_t numOfPages;
+      //! The number of pages the page directory can hold before growing
+      size_t pageCapacity;
+      size_t maxPageSize;
+      size_t* pageSizes;
+      uint8_t** pages;
+      //! The spacing in bytes between each size class
+      size_t classGranularity;
+      //! The number of size classes that fit within a single page
+      size_t numOfClasses;
+      //! Heads of the intrusive free lists kept for each size class
+      void** freeLists;
+
+      //! Marks a page index that doesn't exist
+      static constexpr size_t noPage = SIZE_MAX;
+      //! The number of free space buckets, one for each power of two
+      static constexpr size_t numOfBuckets = sizeof(uint64_t) * CHAR_BIT;
+      //! A bitmap where each set bit marks a non empty free space bucket
+      uint64_t freeSpaceMap;
+      //! The first page in each free space bucket
+      size_t bucketHeads[numOfBuckets];
+      //! The next page within the same free space bucket for each page
+      size_t* nextInBucket;
+      //! The previous page within the same free space bucket for each page
+      size_t* prevInBucket;
+
+      //! Bytes reserved after which the callback is notified (0 is no limit)
+      size_t softMemBudget;
+      //! Bytes reserved that the heap may never exceed (0 is no limit)
+      size_t hardMemBudget;
+      //! Bytes currently reserved by pages
+      size_t memReserved;
+
+      /*!
+       * A dedicated page holding a single span that was too large to fit
+       * within a regular page.
+       */
+      struct LargePage
+      {
+        //! The start of the memory allocated for the page
+        uint8_t *mem;
+        //! The number of bytes allocated for the page
+        size_t memSize;
+        //! The allignment the page was allocated at
+        size_t memAllignment;
+      };
+      //! Every large page currently allocated
+      LargePage* largePages;
+      //! The number of large pages currently allocated
+      size_t numOfLargePages;
+      //! The number of large pages the large page directory can hold
+      size_t largePageCapacity;
+
+      //! The page a monotonic heap is currently bumping from
+      size_t activePage;
+
+      /*!
+       * A non trivial object or array allocated by a monotonic heap whose
+       * destructor is run when the heap is rewound past it.
+       */
+      struct DestructorEntry
+      {
+        //! The first object to destroy
+        void *obj;
+        //! The number of objects to destroy
+        size_t count;
+        //! Destroys the objects as their original type
+        void (*destroy)(void *, size_t);
+      };
+      //! Destructors tracked in order of allocation
+      DestructorEntry* destructors;
+      //! The number of destructors currently tracked
+      size_t numOfDestructors;
+      //! The number of destructors the list can hold before growing
+      size_t destructorCapacity;
+
+      //! The number of free blocks a thread can cache for each size class
+      static constexpr uint32_t threadCacheSize = 16;
+      //! The number of blocks moved between a thread cache and the heap
+      static constexpr uint32_t threadCacheBatch = threadCacheSize / 2;
+      //! The number of thread safe heaps a single thread can cache at once
+      static constexpr size_t maxThreadCacheSlots = 8;
+
+      /*!
+       * The free blocks cached by a single thread for each size class of a
+       * thread safe heap. Caches belong to the heap and are only released
+       * when it is terminated so an exited thread's cache can be adopted.
+       */
+      struct ThreadCache
+      {
+        //! The next cache belonging to the heap
+        ThreadCache *nextCache;
+        //! Whether a thread currently owns the cache
+        bool cacheInUse;
+        //! The number of blocks cached for each size class
+        uint32_t *counts;
+        //! The cached blocks with threadCacheSize slots for each size class
+        void **slots;
+        //! Blocks drained from the remote free lists for each size class
+        void **localFree;
+        //! Blocks freed by other threads into this thread's page for each
+        //! size class, kept apart from the thread's own hot data
+        std::atomic<void*> *remoteFree;
+        //! The page the thread bumps from or nullptr if it has none
+        uint8_t *ownedPageMem;
+        //! The index of the owned page within the page directory
+        size_t ownedPageIndex;
+        //! The bytes used within the owned page
+        size_t ownedPageUsed;
+      };
+
+      /*!
+       * The header at the start of each page of a thread safe heap naming
+       * the thread cache that owns the page if any.
+       */
+      struct PageHeader
+      {
+        std::atomic<ThreadCache*> owner;
+      };
+      //! The bytes at the start of each page taken up by its header
+      size_t pageHeaderSize;
+
+      /*!
+       * The cache a thread uses for a single heap identified by its id.
+       */
+      struct ThreadCacheSlot
+      {
+        size_t heapId;
+        ThreadCache *cache;
+      };
+
+      /*!
+       * Every cache the current thread is using. Caches are returned to
+       * their heap when the thread exits if the heap still exists.
+       */
+      struct ThreadCacheSlots
+      {
+        ThreadCacheSlot slots[maxThreadCacheSlots];
+
+        ~ThreadCacheSlots()
+        {
+          std::lock_guard<std::mutex> liveLock(liveHeapsMutex);
+          for(ThreadCacheSlot &slot : slots)
+          {
+            BasicMemHeap *heap = slot.heapId ? FindLiveHeap(slot.heapId) : nullptr;
+            if(heap)
+            {
+              heap->ReturnThreadCache(slot.cache);
+            }
+          }
+        }
+      };
+
+      //! A unique id given to the heap each time it is initalized
+      size_t heapId;
+      //! Every cache created for the heap
+      ThreadCache* threadCaches;
+      //! Guards the heap's pages and free lists when it is thread safe
+      mutable std::mutex heapMutex;
+      //! The next thread safe heap within the list of live heaps
+      BasicMemHeap *nextLiveHeap;
+
+      //! The id given to the next heap that is initalized
+      static inline std::atomic<size_t> nextHeapId{1};
+      //! Guards the list of live heaps
+      static inline std::mutex liveHeapsMutex;
+      //! Every thread safe heap that is currently initalized
+      static inline BasicMemHeap *liveHeaps = nullptr;
+      //! The caches of the current thread
+      static inline thread_local ThreadCacheSlots threadCacheSlots;
+
+      /*!
+       * The header at the start of each page of a slab heap. The slab's
+       * occupancy bitmap follows right after the header, with a set bit for
+       * every slot in use, and the slots follow the bitmap. Slabs with free
+       * slots are linked into the list of their size class, which a slab
+       * heap keeps in place of the class's free list.
+       */
+      struct SlabHeader
+      {
+        //! The next slab of the same class or within the pool of empty slabs
+        SlabHeader *nextSlab;
+        //! The previous slab of the same class
+        SlabHeader *prevSlab;
+        //! The size in bytes of each slot
+        size_t slotSize;
+        //! The offset of the first slot from the start of the page
+        size_t slotsOffset;
+        //! The size class the slots belong to
+        uint32_t classIndex;
+        //! The number of slots in the slab
+        uint32_t numOfSlots;
+        //! The number of slots in use
+        uint32_t numOfUsed;
+        //! The number of words in the occupancy bitmap
+        uint32_t numOfWords;
+        //! Every bitmap word before this one is full
+        uint32_t freeHint;
+      };
+      //! Slabs that are empty and can be taken by any size class
+      SlabHeader *emptySlabs;
+      //! The number of size classes that are placed within slabs
+      size_t numOfSlabClasses;
+
+      /*!
+       * The links kept within a free block of a buddy heap. The free blocks
+       * of each order are listed in place of the free list of the size 
+       * class with the same index as the order above the smallest.
+       */
+      struct BuddyBlock
+      {
+        BuddyBlock *nextBlock;
+        BuddyBlock *prevBlock;
+      };
+      //! A bitmap where each set bit marks an order with free blocks
+      uint64_t buddyOrderMap;
+      //! The order of the smallest block
+      size_t buddyMinOrder;
+      //! The order of the largest block
+      size_t buddyMaxOrder;
+      //! The number of words in each bitmap at the start of a region
+      size_t buddyWords;
+      //! The bytes at the start of each region taken up by its bitmaps
+      size_t buddyHeaderSize;
+
+      /*!
+       * Gets the index of the size class that an object of the given size
+       * belongs to.
+       */
+      size_t SizeClassIndex(const size_t &objSize) const
+      {
+        // Zero sized objects still take up the smallest class
+        if(!objSize)
+        {
+          return 0;
+        }
+
+        return (objSize - 1) / classGranularity;
+      }
+
+      /*!
+       * Performs the checks shared by every allocation before finding an
+       * alligned block for the object.
+       */
+      MEMERR BeginAllocate(const void *p_Obj, const size_t &objSize
+          , const size_t &in_allignment, void *&block)
+      {
+        // Make sure the heap can be allocated from
+        if(!heapInitalized)
+        {
+          return MEMERR_UNINITALIZED;
+        }
+
+        // Check for a double allocation to avoid allocating over an 
+        //  already allocated object so that we don't risk floating memory
+        //  unless the user has specifically disabled it
+        if(!(memFlags & MEMFLAGS_OVERRIDE_DOUBLE_ALLOC) && p_Obj)
+        {
+          return MEMERR_DOUBLE_ALLOC;
+        }
+
+        return AllocateBlock(objSize, in_allignment, block);
+      }
+
+      /*!
+       * Performs the checks shared by every array allocation before finding
+       * a span for the array within a page or a large page.
+       */
+      MEMERR BeginAllocateArray(const void *p_Arr, const size_t &objSize
+          , const size_t &count, const size_t &in_allignment, void *&span)
+      {
+        // Make sure the heap can be allocated from
+        if(!heapInitalized)
+        {
+          return MEMERR_UNINITALIZED;
+        }
+
+        // Check for a double allocation unless it has been disabled
+        if(!(memFlags & MEMFLAGS_OVERRIDE_DOUBLE_ALLOC) && p_Arr)
+        {
+          return MEMERR_DOUBLE_ALLOC;
+        }
+
+        // Arrays must hold at least one object
+        if(!count)
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        // Make sure the size of the array can be represented
+        if(objSize && count > SIZE_MAX / objSize)
+        {
+          return MEMERR_OUT_OF_MEM;
+        }
+
+        // Place the array within a page when it fits
+        const size_t arrSize = objSize * count;
+        if(FitsInPage(arrSize, in_allignment))
+        {
+          return AllocateBlock(arrSize, in_allignment, span);
+        }
+
+        std::unique_lock<std::mutex> lock = LockHeap();
+        return AllocateLargePage(arrSize, in_allignment, span);
+      }
+
+      /*!
+       * Returns a span given by BeginAllocateArray to the heap.
+       */
+      void ReleaseSpan(void *span, const size_t &objSize, const size_t &count
+          , const size_t &in_allignment)
+      {
+        const size_t arrSize = objSize * count;
+        if(FitsInPage(arrSize, in_allignment))
+        {
+          FreeBlock(span, SizeClassIndex(arrSize));
+        }
+        else
+        {
+          std::unique_lock<std::mutex> lock = LockHeap();
+          ReleaseLargePage(span);
+        }
+      }
+
+      /*!
+       * Destroys the given number of objects starting at the given address
+       * in reverse order of their construction.
+       */
+      template<typename T>
+      static void DestroyArray(T *first, size_t count)
+      {
+        if constexpr(!std::is_trivially_destructible<T>::value)
+        {
+          while(count)
+          {
+            first[--count].~T();
+          }
+        }
+      }
+
+      /*!
+       * Checks if an object of the given size and allignment can be placed
+       * within a regular page.
+       */
+      bool FitsInPage(const size_t &objSize, const size_t &in_allignment) const
+      {
+        const size_t objAllignment = (in_allignment > allignment)
+          ? in_allignment : allignment;
+
+        // Slabs fit an object when its class has room for a slot
+        if(memFlags & MEMFLAGS_SLAB)
+        {
+          return objSize <= maxPageSize && objAllignment <= maxPageSize
+            && SlabClassIndex(objSize, objAllignment) < numOfSlabClasses;
+        }
+
+        // Buddy regions fit blocks up to the largest order left after the
+        // header
+        if(memFlags & MEMFLAGS_BUDDY)
+        {
+          return objSize <= maxPageSize && objAllignment <= maxPageSize
+            && BuddyOrder(objSize, objAllignment) <= buddyMaxOrder;
+        }
+
+        const size_t maxPadding = (objAllignment > classGranularity)
+          ? objAllignment - classGranularity : 0;
+        const size_t objPageSize = (SizeClassIndex(objSize) + 1) 
+          * classGranularity;
+
+        return objPageSize <= maxPageSize - pageHeaderSize
+          && maxPadding <= maxPageSize - pageHeaderSize - objPageSize;
+      }
+
+      /*!
+       * Notifies the callback of a successful allocation.
+       */
+      MEMERR EndAllocate(const size_t &objSize, const void *address)
+      {
+        // Let the policy notify the user that we have allocated a new object
+        // unless debug messages are disabled
+        return policy.Notify(MEMCALL_ALLOC, objSize, address);
+      }
+
+      /*!
+       * Checks if a value is a non zero power of two.
+       */
+      static bool IsPowerOfTwo(const size_t &value)
+      {
+        return value && !(value & (value - 1));
+      }
+
+      /*!
+       * Finds a block within a page for an object of the given size placed
+       * at the given allignment. Freed blocks of the object's size class are
+       * reused when they are alligned well enough, otherwise the block is
+       * bumped from the page picked by the free space index.
+       *
+       * \param objSize
+       *    The size in bytes of the object being placed
+       * \param in_allignment
+       *    The requested allignment which is raised to the heap's allignment
+       * \param block
+       *    Set to the start of the block on success
+       *
+       * \returns
+       *    A memory error result
+       */
+      MEMERR AllocateBlock(const size_t &objSize, const size_t &in_allignment
+          , void *&block)
+      {
+        // Every object is alligned to at least the heap's allignment
+        const size_t objAllignment = (in_allignment > allignment)
+          ? in_allignment : allignment;
+        if(!IsPowerOfTwo(objAllignment))
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        // Get the size class of the object and the total object size within
+        // the page so freed blocks can be handed out again by their class
+        const size_t classIndex = SizeClassIndex(objSize);
+        const size_t objPageSize = (classIndex + 1) * classGranularity;
+
+        // Objects larger than a page can never be placed within the heap
+        if(!FitsInPage(objSize, objAllignment))
+        {
+          return MEMERR_OUT_OF_MEM;
+        }
+
+        // Monotonic heaps always bump forward from their active page
+        if(memFlags & MEMFLAGS_MONOTONIC)
+        {
+          return BumpMonotonic(objPageSize, objAllignment, block);
+        }
+
+        // Slab heaps take a free slot from a slab of the object's class
+        if(memFlags & MEMFLAGS_SLAB)
+        {
+          return AllocateSlabBlock(SlabClassIndex(objSize, objAllignment)
+              , block);
+        }
+
+        // Buddy heaps split the smallest free block that fits the object
+        if(memFlags & MEMFLAGS_BUDDY)
+        {
+          return AllocateBuddyBlock(BuddyOrder(objSize, objAllignment), block);
+        }
+
+        // Thread safe heaps serve blocks from the calling thread's cache
+        // when the class granularity is alligned enough for the object
+        if(memFlags & MEMFLAGS_THREAD_SAFE)
+        {
+          ThreadCache *cache = (objAllignment <= classGranularity)
+            ? GetThreadCache() : nullptr;
+          if(cache)
+          {
+            return AllocateCachedBlock(cache, classIndex, block);
+          }
+
+          std::lock_guard<std::mutex> lock(heapMutex);
+          return AllocateSharedBlock(classIndex, objAllignment, block);
+        }
+
+        return AllocateSharedBlock(classIndex, objAllignment, block);
+      }
+
+      /*!
+       * Gets the size class of a slab slot that keeps an object of the given
+       * size alligned. Slots are alligned to the lowest set bit of their
+       * size so rounding the size up to the allignment is enough.
+       */
+      size_t SlabClassIndex(const size_t &objSize
+          , const size_t &objAllignment) const
+      {
+        return SizeClassIndex((objSize + objAllignment - 1) 
+            & ~(objAllignment - 1));
+      }
+
+      /*!
+       * Finds how many slots of a size class fit within a slab along with
+       * the length of its bitmap and where its slots start. Slots start at
+       * an offset alligned to the lowest set bit of their size so that every
+       * slot is alligned as well as its size allows.
+       */
+      void SlabLayout(const size_t &classIndex, size_t &numOfSlots
+          , size_t &numOfWords, size_t &slotsOffset) const
+      {
+        const size_t slotSize = (classIndex + 1) * classGranularity;
+        const size_t slotAllignment = slotSize & (~slotSize + 1);
+
+        // Every slot takes up its size plus one bit of the bitmap. Start from
+        // that estimate and shrink until the header, the bitmap, and the
+        // alligned slots fit together, which only takes a few steps.
+        const size_t available = (maxPageSize > sizeof(SlabHeader))
+          ? maxPageSize - sizeof(SlabHeader) : 0;
+        numOfSlots = available * CHAR_BIT / (slotSize * CHAR_BIT + 1);
+        while(numOfSlots)
+        {
+          numOfWords = (numOfSlots + 63) / 64;
+          slotsOffset = (sizeof(SlabHeader) + numOfWords * sizeof(uint64_t)
+              + slotAllignment - 1) & ~(slotAllignment - 1);
+          if(slotsOffset <= maxPageSize
+              && numOfSlots * slotSize <= maxPageSize - slotsOffset)
+          {
+            return;
+          }
+          --numOfSlots;
+        }
+        numOfWords = 0;
+        slotsOffset = 0;
+      }
+
+      //! Gets the occupancy bitmap that follows a slab's header
+      static uint64_t *SlabBitmap(const SlabHeader *slab)
+      {
+        return reinterpret_cast<uint64_t*>(const_cast<SlabHeader*>(slab) + 1);
+      }
+
+      //! Gets the bits of slots in use within a word of a slab's bitmap
+      static uint64_t SlabLiveBits(const SlabHeader *slab, const size_t &word)
+      {
+        // The padding bits past the last slot are always set
+        uint64_t live = SlabBitmap(slab)[word];
+        if(word == slab->numOfWords - 1u && (slab->numOfSlots % 64))
+        {
+          live &= ~(~uint64_t(0) << (slab->numOfSlots % 64));
+        }
+
+        return live;
+      }
+
+      /*!
+       * Finds the first bitmap word with a free slot starting from the given
+       * word. The slab must have a free slot at or after the word.
+       */
+      static size_t FindFreeWord(const uint64_t *bitmap, size_t word
+          , const size_t &numOfWords)
+      {
+#ifdef MEMSTAX_AVX2
+        // Compare four words at a time against a full word and stop at the
+        // first group that isn't entirely full
+        const __m256i full = _mm256_set1_epi64x(-1);
+        for(; word + 4 <= numOfWords; word += 4)
+        {
+          const __m256i words = _mm256_loadu_si256(
+              reinterpret_cast<const __m256i*>(bitmap + word));
+          const int fullMask = _mm256_movemask_pd(_mm256_castsi256_pd(
+                _mm256_cmpeq_epi64(words, full)));
+          if(fullMask != 0xF)
+          {
+            return word + LowestBit(~fullMask & 0xF);
+          }
+        }
+#else
+        (void)numOfWords;
+#endif
+
+        while(!~bitmap[word])
+        {
+          ++word;
+        }
+
+        return word;
+      }
+
+      //! Links a slab with free slots into the list of its size class
+      void LinkSlab(SlabHeader *slab)
+      {
+        SlabHeader *head = static_cast<SlabHeader*>(
+            freeLists[slab->classIndex]);
+        slab->prevSlab = nullptr;
+        slab->nextSlab = head;
+        if(head)
+        {
+          head->prevSlab = slab;
+        }
+        freeLists[slab->classIndex] = slab;
+      }
+
+      //! Removes a slab from the list of its size class
+      void UnlinkSlab(SlabHeader *slab)
+      {
+        if(slab->prevSlab)
+        {
+          slab->prevSlab->nextSlab = slab->nextSlab;
+        }
+        else
+        {
+          freeLists[slab->classIndex] = slab->nextSlab;
+        }
+        if(slab->nextSlab)
+        {
+          slab->nextSlab->prevSlab = slab->prevSlab;
+        }
+        slab->nextSlab = nullptr;
+        slab->prevSlab = nullptr;
+      }
+
+      /*!
+       * Takes an empty slab from the pool, allocating a page if there is
+       * none, and lays it out for the given size class.
+       */
+      MEMERR AcquireSlab(const size_t &classIndex, SlabHeader *&slab)
+      {
+        if(!emptySlabs)
+        {
+          const MEMERR error = AllocatePage();
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+        }
+        slab = emptySlabs;
+        emptySlabs = slab->nextSlab;
+
+        size_t numOfSlots = 0;
+        size_t numOfWords = 0;
+        size_t slotsOffset = 0;
+        SlabLayout(classIndex, numOfSlots, numOfWords, slotsOffset);
+        slab->slotSize = (classIndex + 1) * classGranularity;
+        slab->slotsOffset = slotsOffset;
+        slab->classIndex = static_cast<uint32_t>(classIndex);
+        slab->numOfSlots = static_cast<uint32_t>(numOfSlots);
+        slab->numOfUsed = 0;
+        slab->numOfWords = static_cast<uint32_t>(numOfWords);
+        slab->freeHint = 0;
+
+        // Mark the bits past the last slot as used so they are never found
+        uint64_t *bitmap = SlabBitmap(slab);
+        std::memset(bitmap, 0, numOfWords * sizeof(uint64_t));
+        if(numOfSlots % 64)
+        {
+          bitmap[numOfWords - 1] = ~uint64_t(0) << (numOfSlots % 64);
+        }
+
+        LinkSlab(slab);
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Takes the first free slot of a slab of the given size class. The
+       * slab leaves its class's list once it is full.
+       */
+      MEMERR AllocateSlabBlock(const size_t &classIndex, void *&block)
+      {
+        SlabHeader *slab = static_cast<SlabHeader*>(freeLists[classIndex]);
+        if(!slab)
+        {
+          const MEMERR error = AcquireSlab(classIndex, slab);
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+        }
+
+        // Find the first word with a clear bit and take its lowest clear bit
+        uint64_t *bitmap = SlabBitmap(slab);
+        const size_t word = FindFreeWord(bitmap, slab->freeHint
+            , slab->numOfWords);
+        const size_t bit = LowestBit(~bitmap[word]);
+        bitmap[word] |= uint64_t(1) << bit;
+        slab->freeHint = static_cast<uint32_t>(word);
+
+        if(++slab->numOfUsed == slab->numOfSlots)
+        {
+          UnlinkSlab(slab);
+        }
+
+        block = reinterpret_cast<uint8_t*>(slab) + slab->slotsOffset
+          + (word * 64 + bit) * slab->slotSize;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Clears the slot of a block within its slab. A full slab rejoins its
+       * class's list and an empty slab goes back to the pool, unless it is
+       * the only slab its class has left with free slots so that a class
+       * allocating and freeing a single object doesn't lay out a new slab
+       * every time.
+       */
+      void FreeSlabBlock(void *block)
+      {
+        SlabHeader *slab = reinterpret_cast<SlabHeader*>(
+            reinterpret_cast<uintptr_t>(block) & ~(maxPageSize - 1));
+        const size_t slot = (static_cast<uint8_t*>(block) 
+            - reinterpret_cast<uint8_t*>(slab) - slab->slotsOffset) 
+          / slab->slotSize;
+
+        SlabBitmap(slab)[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+        if(slot / 64 < slab->freeHint)
+        {
+          slab->freeHint = static_cast<uint32_t>(slot / 64);
+        }
+
+        if(slab->numOfUsed-- == slab->numOfSlots)
+        {
+          LinkSlab(slab);
+        }
+        if(!slab->numOfUsed && (slab->prevSlab || slab->nextSlab))
+        {
+          UnlinkSlab(slab);
+          slab->nextSlab = emptySlabs;
+          emptySlabs = slab;
+        }
+      }
+
+      /*!
+       * Gets the order of the smallest buddy block that holds an object of
+       * the given size. Blocks are alligned to their own size within a 
+       * region that is alligned to its size, so the block only has to be
+       * at least as large as the allignment as well.
+       */
+      size_t BuddyOrder(const size_t &objSize
+          , const size_t &objAllignment) const
+      {
+        const size_t blockSize = (objSize > objAllignment) 
+          ? objSize : objAllignment;
+        const size_t order = (blockSize > 1) ? FloorLog2(blockSize - 1) + 1 : 0;
+
+        return (order > buddyMinOrder) ? order : buddyMinOrder;
+      }
+
+      /*!
+       * Gets the bit of the first block of an order within a region's 
+       * bitmaps. The blocks of each order follow the blocks of every smaller
+       * order, halving in number as the order grows.
+       */
+      size_t BuddyBitBase(const size_t &order) const
+      {
+        return (maxPageSize >> (buddyMinOrder - 1)) 
+          - (maxPageSize >> (order - 1));
+      }
+
+      //! Gets the bit of the block at an offset within a region's bitmaps
+      size_t BuddyBit(const size_t &offset, const size_t &order) const
+      {
+        return BuddyBitBase(order) + (offset >> order);
+      }
+
+      /*!
+       * Gets the free bitmap at the start of a region, or its allocated
+       * bitmap which follows it.
+       */
+      uint64_t *BuddyBitmap(uint8_t *region, const bool &allocated) const
+      {
+        return reinterpret_cast<uint64_t*>(region) 
+          + (allocated ? buddyWords : 0);
+      }
+
+      //! Checks a bit of a buddy bitmap
+      static bool TestBuddyBit(const uint64_t *bitmap, const size_t &bit)
+      {
+        return (bitmap[bit / 64] >> (bit % 64)) & 1;
+      }
+
+      //! Sets or clears a bit of a buddy bitmap
+      static void SetBuddyBit(uint64_t *bitmap, const size_t &bit
+          , const bool &value)
+      {
+        if(value)
+        {
+          bitmap[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+        else
+        {
+          bitmap[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+        }
+      }
+
+      //! Gets the region a block of a buddy heap lies within
+      uint8_t *BuddyRegionOf(const void *block) const
+      {
+        return reinterpret_cast<uint8_t*>(
+            reinterpret_cast<uintptr_t>(block) & ~(maxPageSize - 1));
+      }
+
+      //! Adds a free block to the list of its order
+      void PushBuddyBlock(uint8_t *region, const size_t &offset
+          , const size_t &order)
+      {
+        BuddyBlock *block = reinterpret_cast<BuddyBlock*>(region + offset);
+        BuddyBlock *head = static_cast<BuddyBlock*>(
+            freeLists[order - buddyMinOrder]);
+        block->prevBlock = nullptr;
+        block->nextBlock = head;
+        if(head)
+        {
+          head->prevBlock = block;
+        }
+        freeLists[order - buddyMinOrder] = block;
+
+        SetBuddyBit(BuddyBitmap(region, false), BuddyBit(offset, order), true);
+        buddyOrderMap |= uint64_t(1) << order;
+      }
+
+      //! Removes a free block from the list of its order
+      void RemoveBuddyBlock(uint8_t *region, const size_t &offset
+          , const size_t &order)
+      {
+        BuddyBlock *block = reinterpret_cast<BuddyBlock*>(region + offset);
+        if(block->prevBlock)
+        {
+          block->prevBlock->nextBlock = block->nextBlock;
+        }
+        else
+        {
+          freeLists[order - buddyMinOrder] = block->nextBlock;
+        }
+        if(block->nextBlock)
+        {
+          block->nextBlock->prevBlock = block->prevBlock;
+        }
+
+        SetBuddyBit(BuddyBitmap(region, false), BuddyBit(offset, order), false);
+        if(!freeLists[order - buddyMinOrder])
+        {
+          buddyOrderMap &= ~(uint64_t(1) << order);
+        }
+      }
+
+      /*!
+       * Clears the bitmaps of a new region and frees the memory after them
+       * as the largest blocks that are alligned to their size.
+       */
+      void InitalizeBuddyRegion(uint8_t *region)
+      {
+        std::memset(region, 0, 2 * buddyWords * sizeof(uint64_t));
+        for(size_t offset = buddyHeaderSize; offset < maxPageSize
+            ; offset += size_t(1) << LowestBit(offset))
+        {
+          PushBuddyBlock(region, offset, LowestBit(offset));
+        }
+      }
+
+      /*!
+       * Takes a free block of the given order, splitting the smallest
+       * larger free block in half until it is the right size when there is
+       * none. A new region is allocated if no block is large enough.
+       */
+      MEMERR AllocateBuddyBlock(const size_t &order, void *&block)
+      {
+        if(!(buddyOrderMap >> order))
+        {
+          const MEMERR error = AllocatePage();
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+        }
+
+        // Take the head of the smallest order with a free block
+        size_t freeOrder = order + LowestBit(buddyOrderMap >> order);
+        uint8_t *mem = static_cast<uint8_t*>(
+            freeLists[freeOrder - buddyMinOrder]);
+        uint8_t *region = BuddyRegionOf(mem);
+        const size_t offset = mem - region;
+        RemoveBuddyBlock(region, offset, freeOrder);
+
+        // Free the upper half of each split
+        while(freeOrder > order)
+        {
+          --freeOrder;
+          PushBuddyBlock(region, offset + (size_t(1) << freeOrder), freeOrder);
+        }
+
+        SetBuddyBit(BuddyBitmap(region, true), BuddyBit(offset, order), true);
+        block = mem;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Frees a block of a buddy heap, merging it with its buddy for as long
+       * as the buddy is free. The block's order is the only order whose
+       * allocated bit is set at its offset.
+       */
+      void FreeBuddyBlock(void *block)
+      {
+        uint8_t *region = BuddyRegionOf(block);
+        size_t offset = static_cast<uint8_t*>(block) - region;
+        uint64_t *allocatedBits = BuddyBitmap(region, true);
+        const uint64_t *freeBits = BuddyBitmap(region, false);
+
+        size_t order = buddyMinOrder;
+        while(order < buddyMaxOrder 
+            && !TestBuddyBit(allocatedBits, BuddyBit(offset, order)))
+        {
+          ++order;
+        }
+        SetBuddyBit(allocatedBits, BuddyBit(offset, order), false);
+
+        // The header is never free so blocks never merge into it
+        while(order < buddyMaxOrder)
+        {
+          const size_t buddyOffset = offset ^ (size_t(1) << order);
+          if(!TestBuddyBit(freeBits, BuddyBit(buddyOffset, order)))
+          {
+            break;
+          }
+          RemoveBuddyBlock(region, buddyOffset, order);
+          offset &= ~(size_t(1) << order);
+          ++order;
+        }
+
+        PushBuddyBlock(region, offset, order);
+      }
+
+      /*!
+       * Finds a block for an object of the given size class and allignment
+       * within the heap's shared free lists and pages. Must be called with
+       * the heap locked when the heap is thread safe.
+       */
+      MEMERR AllocateSharedBlock(const size_t &classIndex
+          , const size_t &objAllignment, void *&block)
+      {
+        const size_t objPageSize = (classIndex + 1) * classGranularity;
+        const size_t maxPadding = (objAllignment > classGranularity)
+          ? objAllignment - classGranularity : 0;
+
+        // If a block of the same size class has been freed then reuse it
+        // instead of growing a page as long as it is alligned for the object
+        void *freeBlock = freeLists[classIndex];
+        if(freeBlock 
+            && !(reinterpret_cast<uintptr_t>(freeBlock) & (objAllignment - 1)))
+        {
+          // Pop the block from the front of the free list
+          freeLists[classIndex] = *static_cast<void**>(freeBlock);
+          block = freeBlock;
+          return MEMERR_NO_ERR;
+        }
+
+        // Look up a page with enough remaining space in the free space index
+        size_t currentPage = FindPage(objPageSize + maxPadding);
+
+        // If no page was found that means that a page with enoguh size does
+        // not exist so we will attempt to allocate a new one
+        if(currentPage == noPage)
+        {
+          MEMERR error = AllocatePage();
+          
+          // Check to see if there was an error and return if there was
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+
+          currentPage = numOfPages - 1;
+        }
+
+        // Bump the page's address up to the allignment of the object
+        const uintptr_t address = reinterpret_cast<uintptr_t>(
+            pages[currentPage] + pageSizes[currentPage]);
+        const size_t padding = static_cast<size_t>(
+            ((address + objAllignment - 1) & ~(uintptr_t(objAllignment) - 1))
+            - address);
+
+        // Hand the padding to the free lists so that it isn't wasted
+        if(padding)
+        {
+          PushFreeBlock(pages[currentPage] + pageSizes[currentPage]
+              , SizeClassIndex(padding));
+        }
+
+        // Update the page size and move the page to the bucket matching its
+        // new remaining space
+        block = pages[currentPage] + pageSizes[currentPage] + padding;
+        UnindexPage(currentPage);
+        pageSizes[currentPage] += padding + objPageSize; 
+        IndexPage(currentPage);
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Returns a block to the free list of its size class. Thread safe 
+       * heaps return it to the calling thread's cache instead, flushing part
+       * of the cache to the shared free list when it is full.
+       */
+      void FreeBlock(void *block, const size_t &classIndex)
+      {
+        // Slab heaps find the block's slab from its address
+        if(memFlags & MEMFLAGS_SLAB)
+        {
+          FreeSlabBlock(block);
+          return;
+        }
+
+        // Buddy heaps find the block's order from the region's bitmaps
+        if(memFlags & MEMFLAGS_BUDDY)
+        {
+          FreeBuddyBlock(block);
+          return;
+        }
+
+        if(memFlags & MEMFLAGS_THREAD_SAFE)
+        {
+          // Blocks of a page owned by another thread go back to that thread
+          ThreadCache *cache = GetThreadCache();
+          ThreadCache *owner = PageHeaderOf(block)->owner.load(
+              std::memory_order_acquire);
+          if(owner && owner != cache)
+          {
+            PushRemoteFree(owner, block, classIndex);
+            return;
+          }
+
+          if(cache)
+          {
+            uint32_t &count = cache->counts[classIndex];
+            if(count == threadCacheSize)
+            {
+              FlushThreadCache(cache, classIndex, threadCacheBatch);
+            }
+            cache->slots[classIndex * threadCacheSize + count++] = block;
+            return;
+          }
+
+          std::lock_guard<std::mutex> lock(heapMutex);
+          PushFreeBlock(block, classIndex);
+          return;
+        }
+
+        PushFreeBlock(block, classIndex);
+      }
+
+      /*!
+       * Pops a block from the calling thread's cache for the given size 
+       * class, refilling the cache with a batch of blocks from the shared
+       * heap when it is empty.
+       */
+      MEMERR AllocateCachedBlock(ThreadCache *cache, const size_t &classIndex
+          , void *&block)
+      {
+        uint32_t &count = cache->counts[classIndex];
+        void **magazine = cache->slots + classIndex * threadCacheSize;
+
+        // Serve the block from the thread's cache first
+        if(count)
+        {
+          block = magazine[--count];
+          return MEMERR_NO_ERR;
+        }
+
+        // Then from blocks other threads have freed back to this thread,
+        // taking the whole remote list at once when the local list is empty
+        void *&localHead = cache->localFree[classIndex];
+        if(!localHead)
+        {
+          localHead = cache->remoteFree[classIndex].exchange(nullptr
+              , std::memory_order_acquire);
+        }
+        if(localHead)
+        {
+          block = localHead;
+          localHead = *static_cast<void**>(block);
+          return MEMERR_NO_ERR;
+        }
+
+        // Then bump the page owned by the thread without locking
+        const size_t objPageSize = (classIndex + 1) * classGranularity;
+        if(BumpOwnedPage(cache, objPageSize, block))
+        {
+          return MEMERR_NO_ERR;
+        }
+
+        // Refill the cache from the shared free list under a single lock of
+        // the heap, taking a new page for the thread if the list is empty
+        std::lock_guard<std::mutex> lock(heapMutex);
+        while(count < threadCacheBatch && freeLists[classIndex])
+        {
+          void *refill = freeLists[classIndex];
+          freeLists[classIndex] = *static_cast<void**>(refill);
+          magazine[count++] = refill;
+        }
+        if(count)
+        {
+          block = magazine[--count];
+          return MEMERR_NO_ERR;
+        }
+
+        MEMERR error = AcquireOwnedPage(cache, objPageSize);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+        BumpOwnedPage(cache, objPageSize, block);
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Bumps a block from the page owned by a thread's cache if it has room.
+       */
+      bool BumpOwnedPage(ThreadCache *cache, const size_t &objPageSize
+          , void *&block)
+      {
+        if(!cache->ownedPageMem 
+            || objPageSize > maxPageSize - cache->ownedPageUsed)
+        {
+          return false;
+        }
+
+        block = cache->ownedPageMem + cache->ownedPageUsed;
+        cache->ownedPageUsed += objPageSize;
+        return true;
+      }
+
+      /*!
+       * Gives a thread's cache a new page to own, handing its current page
+       * back to the shared heap. A page already holding at least half a page
+       * of free space is reused before a new page is allocated. Must be 
+       * called with the heap locked.
+       */
+      MEMERR AcquireOwnedPage(ThreadCache *cache, const size_t &objPageSize)
+      {
+        ReleaseOwnedPage(cache);
+
+        // Reuse a mostly empty page or allocate a new one
+        const size_t halfPage = maxPageSize / 2;
+        size_t page = FindPage((objPageSize > halfPage) ? objPageSize : halfPage);
+        if(page == noPage)
+        {
+          MEMERR error = AllocatePage();
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+          page = numOfPages - 1;
+        }
+
+        // Take the page out of the shared index while it is owned
+        UnindexPage(page);
+        cache->ownedPageIndex = page;
+        cache->ownedPageMem = pages[page];
+        cache->ownedPageUsed = pageSizes[page];
+        PageHeaderOf(pages[page])->owner.store(cache, std::memory_order_release);
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Hands the page a thread's cache bumps from back to the shared heap so
+       * its remaining space can be found by the free space index. The thread
+       * stays the page's owner so blocks it carved are still freed back to
+       * it. Must be called with the heap locked.
+       */
+      void ReleaseOwnedPage(ThreadCache *cache)
+      {
+        if(!cache->ownedPageMem)
+        {
+          return;
+        }
+
+        pageSizes[cache->ownedPageIndex] = cache->ownedPageUsed;
+        IndexPage(cache->ownedPageIndex);
+        cache->ownedPageMem = nullptr;
+      }
+
+      /*!
+       * Pushes a block onto the remote free list of the thread that owns its
+       * page with a single compare and swap.
+       */
+      static void PushRemoteFree(ThreadCache *owner, void *block
+          , const size_t &classIndex)
+      {
+        std::atomic<void*> &head = owner->remoteFree[classIndex];
+        void *oldHead = head.load(std::memory_order_relaxed);
+        do
+        {
+          *static_cast<void**>(block) = oldHead;
+        } while(!head.compare_exchange_weak(oldHead, block
+              , std::memory_order_release, std::memory_order_relaxed));
+      }
+
+      /*!
+       * Gets the header of the page holding a block of a thread safe heap.
+       */
+      PageHeader *PageHeaderOf(void *block) const
+      {
+        return reinterpret_cast<PageHeader*>(
+            reinterpret_cast<uintptr_t>(block) & ~uintptr_t(maxPageSize - 1));
+      }
+
+      /*!
+       * Moves the oldest blocks of a size class from a thread's cache to the
+       * shared free list under a single lock of the heap.
+       */
+      void FlushThreadCache(ThreadCache *cache, const size_t &classIndex
+          , const uint32_t &flushCount)
+      {
+        uint32_t &count = cache->counts[classIndex];
+        void **magazine = cache->slots + classIndex * threadCacheSize;
+        const uint32_t numFlushed = (flushCount < count) ? flushCount : count;
+
+        {
+          std::lock_guard<std::mutex> lock(heapMutex);
+          for(uint32_t i = 0; i < numFlushed; ++i)
+          {
+            PushFreeBlock(magazine[i], classIndex);
+          }
+        }
+
+        // Keep the most recently freed blocks since they are still warm
+        count -= numFlushed;
+        std::memmove(magazine, magazine + numFlushed, count * sizeof(void*));
+      }
+
+      /*!
+       * Gets the calling thread's cache for this heap, adopting a cache 
+       * left behind by an exited thread or creating one on first use.
+       *
+       * \returns
+       *    The thread's cache or nullptr if the thread has no room left to
+       *    cache another heap in which case the heap is locked directly.
+       */
+      ThreadCache *GetThreadCache()
+      {
+        ThreadCacheSlot *freeSlot = nullptr;
+        for(ThreadCacheSlot &slot : threadCacheSlots.slots)
+        {
+          if(slot.heapId == heapId)
+          {
+            return slot.cache;
+          }
+          if(!slot.heapId && !freeSlot)
+          {
+            freeSlot = &slot;
+          }
+        }
+
+        // Clear out slots for heaps that no longer exist if none are free
+        if(!freeSlot)
+        {
+          std::lock_guard<std::mutex> liveLock(liveHeapsMutex);
+          for(ThreadCacheSlot &slot : threadCacheSlots.slots)
+          {
+            if(!FindLiveHeap(slot.heapId))
+            {
+              slot.heapId = 0;
+              slot.cache = nullptr;
+              freeSlot = freeSlot ? freeSlot : &slot;
+            }
+          }
+          if(!freeSlot)
+          {
+            return nullptr;
+          }
+        }
+
+        // Adopt an abandoned cache or create a new one for the thread
+        std::lock_guard<std::mutex> lock(heapMutex);
+        ThreadCache *cache = threadCaches;
+        while(cache && cache->cacheInUse)
+        {
+          cache = cache->nextCache;
+        }
+        if(!cache && CreateThreadCache(cache) != MEMERR_NO_ERR)
+        {
+          return nullptr;
+        }
+
+        cache->cacheInUse = true;
+        freeSlot->heapId = heapId;
+        freeSlot->cache = cache;
+        return cache;
+      }
+
+      /*!
+       * Creates an empty thread cache and adds it to the heap's list of 
+       * caches. Must be called with the heap locked.
+       */
+      MEMERR CreateThreadCache(ThreadCache *&cache)
+      {
+        cache = nullptr;
+        MEMERR error = TryAllocate<ThreadCache>(cache);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        cache->slots = nullptr;
+        cache->counts = nullptr;
+        cache->localFree = nullptr;
+        cache->remoteFree = nullptr;
+        error = TryAllocate<void*>(cache->slots, numOfClasses * threadCacheSize);
+        if(error == MEMERR_NO_ERR)
+        {
+          error = TryAllocate<uint32_t>(cache->counts, numOfClasses);
+        }
+        if(error == MEMERR_NO_ERR)
+        {
+          error = TryAllocate<void*>(cache->localFree, numOfClasses);
+        }
+        if(error == MEMERR_NO_ERR)
+        {
+          error = TryAllocate<std::atomic<void*>>(cache->remoteFree
+              , numOfClasses);
+        }
+        if(error != MEMERR_NO_ERR)
+        {
+          ReleaseThreadCache(cache);
+          return error;
+        }
+
+        // Start with every class empty
+        for(size_t i = 0; i < numOfClasses; ++i)
+        {
+          cache->counts[i] = 0;
+          cache->localFree[i] = nullptr;
+          cache->remoteFree[i].store(nullptr, std::memory_order_relaxed);
+        }
+        cache->ownedPageMem = nullptr;
+        cache->ownedPageIndex = noPage;
+        cache->ownedPageUsed = 0;
+        cache->cacheInUse = false;
+        cache->nextCache = threadCaches;
+        threadCaches = cache;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Flushes every block held by a thread's cache back to the shared heap
+       * and leaves the cache to be adopted by another thread.
+       */
+      void ReturnThreadCache(ThreadCache *cache)
+      {
+        std::lock_guard<std::mutex> lock(heapMutex);
+
+        // Stop other threads from freeing into the cache's pages
+        ReleaseOwnedPage(cache);
+        for(size_t i = 0; i < numOfPages; ++i)
+        {
+          std::atomic<ThreadCache*> &owner = PageHeaderOf(pages[i])->owner;
+          if(owner.load(std::memory_order_relaxed) == cache)
+          {
+            owner.store(nullptr, std::memory_order_release);
+          }
+        }
+
+        for(size_t i = 0; i < numOfClasses; ++i)
+        {
+          void **magazine = cache->slots + i * threadCacheSize;
+          for(uint32_t j = 0; j < cache->counts[i]; ++j)
+          {
+            PushFreeBlock(magazine[j], i);
+          }
+          cache->counts[i] = 0;
+
+          // Move the local and remote free lists over as well
+          void *chain = cache->remoteFree[i].exchange(nullptr
+              , std::memory_order_acquire);
+          while(chain)
+          {
+            void *next = *static_cast<void**>(chain);
+            PushFreeBlock(chain, i);
+            chain = next;
+          }
+          while(cache->localFree[i])
+          {
+            void *next = *static_cast<void**>(cache->localFree[i]);
+            PushFreeBlock(cache->localFree[i], i);
+            cache->localFree[i] = next;
+          }
+        }
+        cache->cacheInUse = false;
+      }
+
+      /*!
+       * Releases the memory of a thread cache.
+       */
+      void ReleaseThreadCache(ThreadCache *&cache)
+      {
+        if(cache->slots)
+        {
+          ReleaseArray<void*>(cache->slots, numOfClasses * threadCacheSize);
+        }
+        if(cache->counts)
+        {
+          ReleaseArray<uint32_t>(cache->counts, numOfClasses);
+        }
+        if(cache->localFree)
+        {
+          ReleaseArray<void*>(cache->localFree, numOfClasses);
+        }
+        if(cache->remoteFree)
+        {
+          ReleaseArray<std::atomic<void*>>(cache->remoteFree, numOfClasses);
+        }
+        ReleaseArray<ThreadCache>(cache);
+      }
+
+      /*!
+       * Finds a live thread safe heap by its id. Must be called with the
+       * live heaps locked.
+       */
+      static BasicMemHeap *FindLiveHeap(const size_t &in_heapId)
+      {
+        BasicMemHeap *heap = liveHeaps;
+        while(heap && heap->heapId != in_heapId)
+        {
+          heap = heap->nextLiveHeap;
+        }
+
+        return heap;
+      }
+
+      /*!
+       * Locks the heap if it is thread safe.
+       */
+      std::unique_lock<std::mutex> LockHeap() const
+      {
+        if(memFlags & MEMFLAGS_THREAD_SAFE)
+        {
+          return std::unique_lock<std::mutex>(heapMutex);
+        }
+
+        return std::unique_lock<std::mutex>();
+      }
+
+      /*!
+       * Bumps a block from the active page of a monotonic heap, moving on to
+       * the next page once the active page is full. Pages past the active
+       * page are always empty so moving on never needs a search.
+       */
+      MEMERR BumpMonotonic(const size_t &objPageSize
+          , const size_t &objAllignment, void *&block)
+      {
+        while(true)
+        {
+          // Bump the page's address up to the allignment of the object
+          const uintptr_t address = reinterpret_cast<uintptr_t>(
+              pages[activePage] + pageSizes[activePage]);
+          const size_t padding = static_cast<size_t>(
+              ((address + objAllignment - 1) & ~(uintptr_t(objAllignment) - 1))
+              - address);
+
+          // Place the block if it fits within the active page
+          if(padding + objPageSize <= maxPageSize - pageSizes[activePage])
+          {
+            block = pages[activePage] + pageSizes[activePage] + padding;
+            pageSizes[activePage] += padding + objPageSize;
+            return MEMERR_NO_ERR;
+          }
+
+          // Move on to the next page allocating it if it doesn't exist yet
+          if(activePage + 1 >= numOfPages)
+          {
+            MEMERR error = AllocatePage();
+            if(error != MEMERR_NO_ERR)
+            {
+              return error;
+            }
+          }
+          ++activePage;
+        }
+      }
+
+      /*!
+       * Records the destructor of a non trivial object allocated by a
+       * monotonic heap that tracks destructors so it can be run on rewind.
+       * Destroys the object if it can't be tracked.
+       */
+      template<typename T>
+      MEMERR TrackDestructor(T *&p_Obj, const size_t &count)
+      {
+        if constexpr(!std::is_trivially_destructible<T>::value)
+        {
+          const uint8_t trackFlags = MEMFLAGS_MONOTONIC 
+            | MEMFLAGS_TRACK_DESTRUCTORS;
+          if((memFlags & trackFlags) != trackFlags)
+          {
+            return MEMERR_NO_ERR;
+          }
+
+          // Grow the destructor list if it is full
+          if(numOfDestructors >= destructorCapacity)
+          {
+            MEMERR error = GrowDestructors();
+            if(error != MEMERR_NO_ERR)
+            {
+              DestroyArray(p_Obj, count);
+              p_Obj = nullptr;
+              return error;
+            }
+          }
+
+          destructors[numOfDestructors++] = { p_Obj, count
+            , [](void *obj, size_t objCount)
+            {
+              DestroyArray(static_cast<T*>(obj), objCount);
+            } };
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Runs tracked destructors in reverse order until only the given
+       * number of them remain.
+       */
+      void RunDestructors(const size_t &remaining)
+      {
+        while(numOfDestructors > remaining)
+        {
+          const DestructorEntry &entry = destructors[--numOfDestructors];
+          entry.destroy(entry.obj, entry.count);
+        }
+      }
+
+      /*!
+       * Doubles the capacity of the tracked destructor list.
+       */
+      MEMERR GrowDestructors()
+      {
+        const size_t newCapacity = destructorCapacity 
+          ? destructorCapacity * 2 : defaultNumOfPages;
+
+        DestructorEntry *newDestructors = nullptr;
+        MEMERR error = TryAllocate<DestructorEntry>(newDestructors
+            , newCapacity);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Copy every entry into the larger list and swap it in
+        for(size_t i = 0; i < numOfDestructors; ++i)
+        {
+          newDestructors[i] = destructors[i];
+        }
+        if(destructors)
+        {
+          ReleaseArray<DestructorEntry>(destructors, destructorCapacity);
+        }
+        destructors = newDestructors;
+        destructorCapacity = newCapacity;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Gets the index of the highest set bit of a non zero value.
+       */
+      static size_t FloorLog2(const uint64_t &value)
+      {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return index;
+#else
+        return numOfBuckets - 1 - __builtin_clzll(value);
+#endif
+      }
+
+      /*!
+       * Gets the index of the lowest set bit of a non zero value.
+       */
+      static size_t LowestBit(const uint64_t &value)
+      {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return index;
+#else
+        return __builtin_ctzll(value);
+#endif
+      }
+
+      /*!
+       * Gets the number of set bits of a value.
+       */
+      static size_t PopCount(const uint64_t &value)
+      {
+#if defined(_MSC_VER)
+        return __popcnt64(value);
+#else
+        return __builtin_popcountll(value);
+#endif
+      }
+
+      /*!
+       * Finds a page with at least the given amount of space remaining in
+       * constant time. Pages are bucketed by the power of two of their
+       * remaining space so any page in a bucket above the size's own bucket
+       * is guaranteed to fit, while the size's own bucket is only probed at
+       * its head.
+       *
+       * \returns
+       *    The index of a page with enough space or noPage if none exists.
+       */
+      size_t FindPage(const size_t &objPageSize) const
+      {
+        const size_t bucket = FloorLog2(objPageSize);
+
+        // Probe the first page of the matching bucket since it may still fit
+        const size_t head = bucketHeads[bucket];
+        if(head != noPage && maxPageSize - pageSizes[head] >= objPageSize)
+        {
+          return head;
+        }
+
+        // Otherwise take the fullest page from the buckets that always fit
+        if(bucket + 1 >= numOfBuckets)
+        {
+          return noPage;
+        }
+        const uint64_t fitting = freeSpaceMap & (~uint64_t(0) << (bucket + 1));
+        if(!fitting)
+        {
+          return noPage;
+        }
+
+        return bucketHeads[LowestBit(fitting)];
+      }
+
+      /*!
+       * Adds a page to the free space bucket matching its remaining space.
+       * Full pages are not indexed.
+       */
+      void IndexPage(const size_t &page)
+      {
+        const size_t remaining = maxPageSize - pageSizes[page];
+        if(!remaining)
+        {
+          return;
+        }
+
+        // Link the page at the front of its bucket and mark the bucket used
+        const size_t bucket = FloorLog2(remaining);
+        prevInBucket[page] = noPage;
+        nextInBucket[page] = bucketHeads[bucket];
+        if(bucketHeads[bucket] != noPage)
+        {
+          prevInBucket[bucketHeads[bucket]] = page;
+        }
+        bucketHeads[bucket] = page;
+        freeSpaceMap |= uint64_t(1) << bucket;
+      }
+
+      /*!
+       * Removes a page from the free space bucket matching its remaining
+       * space. Must be called before the page's size is changed.
+       */
+      void UnindexPage(const size_t &page)
+      {
+        const size_t remaining = maxPageSize - pageSizes[page];
+        if(!remaining)
+        {
+          return;
+        }
+
+        // Unlink the page from its neighbours within the bucket
+        const size_t bucket = FloorLog2(remaining);
+        if(prevInBucket[page] != noPage)
+        {
+          nextInBucket[prevInBucket[page]] = nextInBucket[page];
+        }
+        else
+        {
+          bucketHeads[bucket] = nextInBucket[page];
+        }
+        if(nextInBucket[page] != noPage)
+        {
+          prevInBucket[nextInBucket[page]] = prevInBucket[page];
+        }
+
+        // Clear the bucket's bit once it has no pages left
+        if(bucketHeads[bucket] == noPage)
+        {
+          freeSpaceMap &= ~(uint64_t(1) << bucket);
+        }
+      }
+
+      /*!
+       * Pushes a freed block onto the front of its size class free list by
+       * storing the previous head within the block itself.
+       */
+      void PushFreeBlock(void *block, const size_t &classIndex)
+      {
+        *static_cast<void**>(block) = freeLists[classIndex];
+        freeLists[classIndex] = block;
+      }
+
+      /*!
+       * Releases memory created by TryAllocate without a given address
+       * matching the array or single object form it was created with.
+       */
+      template<typename T>
+      void ReleaseArray(T *&p_obj, const size_t sizeOverride = 1)
+      {
+        if(sizeOverride > 1)
+        {
+          delete[] p_obj;
+        }
+        else
+        {
+          delete p_obj;
+        }
+
+        p_obj = nullptr;
+      }
+
+      template<typename T>
+      MEMERR TryAllocate(T *&p_obj, const size_t sizeOverride = 1
+          , void *addressPtr = nullptr)
+      {
+        // Attempt to allocate a new object of designated size at
+        // given address if provided 
+        try
+        {
+          if(addressPtr)
+          {
+            if(sizeOverride > 1)
+            {
+              p_obj = new(addressPtr) T[sizeOverride];
+            }
+            else
+            {
+              p_obj = new(addressPtr) T;
+            }
+          }
+          else
+          {
+            if(sizeOverride > 1)
+            {
+              p_obj = new T[sizeOverride];
+            }
+            else
+            {
+              p_obj = new T;
+            }
+          }
+        }
+        catch(const std::bad_alloc &e)
+        {
+          // Initalize to avoid a non-error passing an error
+          MEMERR error = MEMERR_NO_ERR;
+
+          // If there was an error with calling new then call the callback
+          // funciton if avaliable to print a message then return
+          // an out of mem error to the user so they are able to respond
+          // appropriatly
+          error = policy.Notify(MEMCALL_MEM_ERR, sizeof(T) * sizeOverride);
+
+          // Make sure no errors occured during callback... 
+          // if there was an error then return the error to user :)
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+
+          return MEMERR_OUT_OF_MEM;
+        }
+        catch(const std::exception &e)
+        {
+          // Initalize to avoid a non-error passing an error
+          MEMERR error = MEMERR_NO_ERR;
+
+          // If there was an error with calling new then call the callback
+          // funciton if avaliable to print a message then return
+          // an out of mem error to the user so they are able to respond
+          // appropriatly
+          error = policy.Notify(MEMCALL_MEM_ERR, sizeof(T) * sizeOverride);
+
+          // Make sure no errors occured during callback... 
+          // if there was an error then return the error to user :)
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+
+          return MEMERR_UNKNOWN;
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Constructs an object at the given address by forwarding the given
+       * arguments to its constructor. Errors are reported the same way as
+       * TryAllocate.
+       */
+      template<typename T, typename... Args>
+      MEMERR TryEmplace(T *&p_obj, void *addressPtr, Args&&... args)
+      {
+        try
+        {
+          p_obj = new(addressPtr) T(std::forward<Args>(args)...);
+        }
+        catch(const std::bad_alloc &e)
+        {
+          // Notify the callback and report that memory ran out
+          const MEMERR error = policy.Notify(MEMCALL_MEM_ERR, sizeof(T));
+
+          return (error != MEMERR_NO_ERR) ? error : MEMERR_OUT_OF_MEM;
+        }
+        catch(const std::exception &e)
+        {
+          // Notify the callback and report that the constructor failed
+          const MEMERR error = policy.Notify(MEMCALL_MEM_ERR, sizeof(T));
+
+          return (error != MEMERR_NO_ERR) ? error : MEMERR_UNKNOWN;
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Allocates each array of the page directory with the given capacity.
+       * If any array fails to allocate then all of them are released.
+       */
+      MEMERR AllocatePageDirectory(uint8_t **&in_pages, size_t *&in_pageSizes
+          , size_t *&in_nextInBucket, size_t *&in_prevInBucket
+          , const size_t &capacity)
+      {
+        in_pages = nullptr;
+        in_pageSizes = nullptr;
+        in_nextInBucket = nullptr;
+        in_prevInBucket = nullptr;
+
+        MEMERR error = TryAllocate<uint8_t*>(in_pages, capacity);
+        if(error == MEMERR_NO_ERR)
+        {
+          error = TryAllocate<size_t>(in_pageSizes, capacity);
+        }
+        if(error == MEMERR_NO_ERR)
+        {
+          error = TryAllocate<size_t>(in_nextInBucket, capacity);
+        }
+        if(error == MEMERR_NO_ERR)
+        {
+          error = TryAllocate<size_t>(in_prevInBucket, capacity);
+        }
+
+        // Don't leave a partial directory behind on failure
+        if(error != MEMERR_NO_ERR)
+        {
+          ReleasePageDirectory(in_pages, in_pageSizes, in_nextInBucket
+              , in_prevInBucket, capacity);
+        }
+
+        return error;
+      }
+
+      /*!
+       * Releases each array of a page directory without releasing the pages
+       * that it points to.
+       */
+      void ReleasePageDirectory(uint8_t **&in_pages, size_t *&in_pageSizes
+          , size_t *&in_nextInBucket, size_t *&in_prevInBucket
+          , const size_t &capacity)
+      {
+        if(in_pages)
+        {
+          ReleaseArray<uint8_t*>(in_pages, capacity);
+        }
+        if(in_pageSizes)
+        {
+          ReleaseArray<size_t>(in_pageSizes, capacity);
+        }
+        if(in_nextInBucket)
+        {
+          ReleaseArray<size_t>(in_nextInBucket, capacity);
+        }
+        if(in_prevInBucket)
+        {
+          ReleaseArray<size_t>(in_prevInBucket, capacity);
+        }
+      }
+
+      /*!
+       * Doubles the capacity of the page directory, copying every existing
+       * entry over so that page indices stay the same. Doubling keeps the
+       * cost of growing constant when spread over every page allocated.
+       */
+      MEMERR GrowPageDirectory()
+      {
+        const size_t newCapacity = pageCapacity * 2;
+
+        // Make sure the capacity hasn't overflowed
+        if(newCapacity <= pageCapacity)
+        {
+          return MEMERR_OUT_OF_MEM;
+        }
+
+        uint8_t **newPages;
+        size_t *newPageSizes;
+        size_t *newNextInBucket;
+        size_t *newPrevInBucket;
+        MEMERR error = AllocatePageDirectory(newPages, newPageSizes
+            , newNextInBucket, newPrevInBucket, newCapacity);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Copy every entry into the larger directory
+        for(size_t i = 0; i < numOfPages; ++i)
+        {
+          newPages[i] = pages[i];
+          newPageSizes[i] = pageSizes[i];
+          newNextInBucket[i] = nextInBucket[i];
+          newPrevInBucket[i] = prevInBucket[i];
+        }
+
+        // Swap the old directory out for the new one
+        ReleasePageDirectory(pages, pageSizes, nextInBucket, prevInBucket
+            , pageCapacity);
+        pages = newPages;
+        pageSizes = newPageSizes;
+        nextInBucket = newNextInBucket;
+        prevInBucket = newPrevInBucket;
+        pageCapacity = newCapacity;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Reserves the given number of bytes against the memory budgets.
+       * Fails if the hard budget would be exceeded and notifies the callback
+       * when the soft budget is first passed.
+       */
+      MEMERR ReserveMem(const size_t &memSize)
+      {
+        // Make sure we don't go over the hard limit
+        if(hardMemBudget && memSize > hardMemBudget - memReserved)
+        {
+          return MEMERR_OUT_OF_MEM;
+        }
+
+        const size_t prevReserved = memReserved;
+        memReserved += memSize;
+
+        // Let the user know once the soft limit has been crossed
+        if(softMemBudget && prevReserved <= softMemBudget
+            && memReserved > softMemBudget)
+        {
+          policy.Notify(MEMCALL_MEM_LIMIT, memReserved);
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Allocates a dedicated large page for a span that can't fit within a
+       * regular page. The index of the large page is stored right before the
+       * span so it can be found again in constant time when released.
+       */
+      MEMERR AllocateLargePage(const size_t &spanSize
+          , const size_t &in_allignment, void *&span)
+      {
+        // Allign the span to at least the allignment of pages
+        size_t spanAllignment = (in_allignment > PageAllignment())
+          ? in_allignment : PageAllignment();
+        if(!IsPowerOfTwo(spanAllignment))
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
+
+        // Leave room before the span for the large page index while keeping
+        // the span alligned
+        const size_t headerSize = (sizeof(size_t) + spanAllignment - 1) 
+          & ~(spanAllignment - 1);
+        if(spanSize > SIZE_MAX - headerSize)
+        {
+          return MEMERR_OUT_OF_MEM;
+        }
+        const size_t memSize = headerSize + spanSize;
+
+        // Grow the large page directory if it is full
+        MEMERR error = MEMERR_NO_ERR;
+        if(numOfLargePages >= largePageCapacity)
+        {
+          error = GrowLargePageDirectory();
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+        }
+
+        // Make sure the memory budget allows the large page
+        error = ReserveMem(memSize);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Attempt to allocate the large page
+        uint8_t *mem = nullptr;
+        try
+        {
+          mem = static_cast<uint8_t*>(::operator new(memSize
+                , std::align_val_t(spanAllignment)));
+        }
+        catch(const std::bad_alloc &e)
+        {
+          memReserved -= memSize;
+          error = policy.Notify(MEMCALL_MEM_ERR, memSize);
+
+          return (error != MEMERR_NO_ERR) ? error : MEMERR_OUT_OF_MEM;
+        }
+
+        // Record the large page and store its index before the span
+        largePages[numOfLargePages] = { mem, memSize, spanAllignment };
+        span = mem + headerSize;
+        std::memcpy(static_cast<uint8_t*>(span) - sizeof(size_t)
+            , &numOfLargePages, sizeof(size_t));
+        ++numOfLargePages;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Releases the large page holding the given span. The last large page
+       * is moved into the released page's slot to keep the directory packed.
+       */
+      void ReleaseLargePage(void *span)
+      {
+        // Read the index of the large page stored before the span
+        size_t index;
+        std::memcpy(&index, static_cast<uint8_t*>(span) - sizeof(size_t)
+            , sizeof(size_t));
+
+        // Free the page's memory and give it back to the budget
+        LargePage &page = largePages[index];
+        memReserved -= page.memSize;
+        ::operator delete(page.mem, std::align_val_t(page.memAllignment));
+
+        // Move the last large page into the empty slot and update its index
+        if(index != --numOfLargePages)
+        {
+          page = largePages[numOfLargePages];
+          const size_t headerSize = (sizeof(size_t) + page.memAllignment - 1)
+            & ~(page.memAllignment - 1);
+          std::memcpy(page.mem + headerSize - sizeof(size_t), &index
+              , sizeof(size_t));
+        }
+      }
+
+      /*!
+       * Releases every large page along with the large page directory.
+       */
+      void ReleaseLargePages()
+      {
+        for(size_t i = 0; i < numOfLargePages; ++i)
+        {
+          memReserved -= largePages[i].memSize;
+          ::operator delete(largePages[i].mem
+              , std::align_val_t(largePages[i].memAllignment));
+        }
+        if(largePages)
+        {
+          ReleaseArray<LargePage>(largePages, largePageCapacity);
+        }
+        numOfLargePages = 0;
+        largePageCapacity = 0;
+      }
+
+      /*!
+       * Doubles the capacity of the large page directory.
+       */
+      MEMERR GrowLargePageDirectory()
+      {
+        const size_t newCapacity = largePageCapacity 
+          ? largePageCapacity * 2 : defaultNumOfPages;
+
+        // Make sure the capacity hasn't overflowed
+        if(newCapacity <= largePageCapacity)
+        {
+          return MEMERR_OUT_OF_MEM;
+        }
+
+        LargePage *newLargePages = nullptr;
+        MEMERR error = TryAllocate<LargePage>(newLargePages, newCapacity);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Copy every entry into the larger directory and swap it in
+        for(size_t i = 0; i < numOfLargePages; ++i)
+        {
+          newLargePages[i] = largePages[i];
+        }
+        if(largePages)
+        {
+          ReleaseArray<LargePage>(largePages, largePageCapacity);
+        }
+        largePages = newLargePages;
+        largePageCapacity = newCapacity;
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Allocates the memory for a single page alligned to the class 
+       * granularity so that every block within it starts alligned.
+       */
+      MEMERR TryAllocatePageMem(uint8_t *&page)
+      {
+        try
+        {
+          page = static_cast<uint8_t*>(::operator new(maxPageSize
+                , std::align_val_t(PageAllignment())));
+        }
+        catch(const std::bad_alloc &e)
+        {
+          // Notify the callback that the page couldn't be allocated
+          const MEMERR error = policy.Notify(MEMCALL_MEM_ERR, maxPageSize);
+          if(error != MEMERR_NO_ERR)
+          {
+            return error;
+          }
+
+          return MEMERR_OUT_OF_MEM;
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Releases the memory of a page allocated by TryAllocatePageMem.
+       */
+      void ReleasePageMem(uint8_t *&page)
+      {
+        ::operator delete(page, std::align_val_t(PageAllignment()));
+        page = nullptr;
+      }
+
+      /*!
+       * Gets the allignment that every page is allocated at.
+       */
+      size_t PageAllignment() const
+      {
+        // Pages of thread safe, slab, and buddy heaps are alligned to their
+        // own size so the page header of any block can be found from its
+        // address
+        if(memFlags & (MEMFLAGS_THREAD_SAFE | MEMFLAGS_SLAB | MEMFLAGS_BUDDY))
+        {
+          return maxPageSize;
+        }
+
+        return (classGranularity > alignof(std::max_align_t))
+          ? classGranularity : alignof(std::max_align_t);
+      }
+
+      MEMERR AllocatePage()
+      {
+        // Make sure the memory budget allows another page!
+        MEMERR error = ReserveMem(maxPageSize);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Grow the page directory if it is full
+        if(numOfPages >= pageCapacity)
+        {
+          error = GrowPageDirectory();
+        }
+
+        // Attempt to allocate a new page
+        if(error == MEMERR_NO_ERR)
+        {
+          error = TryAllocatePageMem(pages[numOfPages]); 
+        }
+
+        // If something failed give back the reserved memory
+        if(error != MEMERR_NO_ERR)
+        {
+          memReserved -= maxPageSize;
+          return error;
+        }
+
+        // Otherwise make the empty page findable by allocations. Monotonic
+        // heaps bump through pages in order so they don't index them.
+        if(pageHeaderSize)
+        {
+          new(pages[numOfPages]) PageHeader{ { nullptr } };
+        }
+        pageSizes[numOfPages] = pageHeaderSize;
+        if(memFlags & MEMFLAGS_SLAB)
+        {
+          // New slabs wait in the pool until a size class needs one
+          SlabHeader *slab = new(pages[numOfPages]) SlabHeader{};
+          slab->nextSlab = emptySlabs;
+          emptySlabs = slab;
+        }
+        else if(memFlags & MEMFLAGS_BUDDY)
+        {
+          InitalizeBuddyRegion(pages[numOfPages]);
+        }
+        else if(!(memFlags & MEMFLAGS_MONOTONIC))
+        {
+          IndexPage(numOfPages);
+        }
+        ++numOfPages;
+        
+        // Return whatever message try allocate returned
+        return error;
+      }
+  };
+
+  //! The heap used by default which sends its messages to a MemCallback
+  using MemHeap = BasicMemHeap<MemCallbackPolicy>;
+
+  /*!
+   * Holds the heap that a memory handle allocates from. When a heap is bound
+   * at compile time the binding is empty and takes up no space within the
+   * handle, otherwise the heap is given at runtime and stored.
+   */
+  template<auto heapBinding>
+  class MemHeapBinding
+  {
+    public:
+      //! The type of heap bound, which may use any callback policy
+      using HeapType = std::remove_pointer_t<decltype(heapBinding)>;
+
+      MemHeapBinding(HeapType * = nullptr)
+      {
+
+      }
+
+      //! Gets the heap bound at compile time
+      auto *GetHeap() const
+      {
+        return heapBinding;
+      }
+  };
+
+  /*!
+   * The runtime form of MemHeapBinding which stores the heap it was given.
+   */
+  template<>
+  class MemHeapBinding<nullptr>
+  {
+    public:
+      //! Heaps given at runtime are always the default MemHeap
+      using HeapType = MemHeap;
+
+      MemHeapBinding(MemHeap *in_heap = nullptr)
+        : heap(in_heap)
+      {
+
+      }
+
+      //! Gets the heap given at runtime
+      MemHeap *GetHeap() const
+      {
+        return heap;
+      }
+
+    private:
+      MemHeap *heap;
+  };
+
+  /*!
+   * \class StaticMem
+   * \brief
+   *    Creates memory in the heap that deletes automatically once it is out
+   *    of scope. Only one StaticMem can own an object at a time so it can
+   *    be moved but never copied.
+   *
+   *    When the heap is bound at compile time, such as 
+   *    StaticMem<T, &globalHeap>, the handle is exactly the size of a 
+   *    pointer. Otherwise the heap is given on construction and stored
+   *    next to the pointer.
+   *
+   * \deprecated
+   *    N/A
+   *
+   * \bug
+   *    N/A
+   */
+  template<typename T, auto heapBinding = nullptr>
+  class StaticMem : private MemHeapBinding<heapBinding>
+  {
+    public:
+      /*!
+       * Creates an empty handle for a heap bound at compile time.
+       */
+      StaticMem()
+        : MemHeapBinding<heapBinding>(), p_Obj(nullptr)
+      {
+
+      }
+
+      /*!
+       * Creates an empty handle that allocates from the given heap.
+       */
+      explicit StaticMem(
+          typename MemHeapBinding<heapBinding>::HeapType &in_heap)
+        : MemHeapBinding<heapBinding>(&in_heap), p_Obj(nullptr)
+      {
+        static_assert(heapBinding == nullptr
+            , "The heap of a StaticMem is already bound at compile time");
+      }
+
+      //! Dtor which returns the object to the heap if one is owned
+      ~StaticMem()
+      {
+        Deallocate();
+      }
+
+      StaticMem(const StaticMem &) = delete;
+      StaticMem &operator=(const StaticMem &) = delete;
+
+      //! Takes ownership of another handle's object
+      StaticMem(StaticMem &&other) noexcept
+        : MemHeapBinding<heapBinding>(other), p_Obj(other.p_Obj)
+      {
+        other.p_Obj = nullptr;
+      }
+
+      //! Releases the current object and takes ownership of another's
+      StaticMem &operator=(StaticMem &&other) noexcept
+      {
+        if(this != &other)
+        {
+          Deallocate();
+          MemHeapBinding<heapBinding>::operator=(other);
+          p_Obj = other.p_Obj;
+          other.p_Obj = nullptr;
+        }
+
+        return *this;
+      }
+
+      /*!
+       * Allocates the owned object by constructing it from the given
+       * arguments within the heap.
+       *
+       * \param args
+       *    The arguments forwarded to the object's constructor
+       *
+       * \returns
+       *    A memory error result. Fails with a double allocation if the
+       *    handle already owns an object.
+       */
+      template<typename... Args>
+      MEMERR Emplace(Args&&... args)
+      {
+        if(!this->GetHeap())
+        {
+          return MEMERR_UNINITALIZED;
+        }
+
+        return this->GetHeap()->Emplace(p_Obj, std::forward<Args>(args)...);
+      }
+
+      /*!
+       * Destroys the owned object and returns it to the heap. Does nothing
+       * if no object is owned.
+       */
+      MEMERR Deallocate()
+      {
+        if(!p_Obj)
+        {
+          return MEMERR_NO_ERR;
+        }
+
+        return this->GetHeap()->Deallocate(p_Obj);
+      }
+
+      /*!
+       * Gives up ownership of the object without deallocating it. The
+       * caller becomes responsible for returning it to the heap.
+       */
+      T *Release()
+      {
+        T *p_released = p_Obj;
+        p_Obj = nullptr;
+        return p_released;
+      }
+
+      //! Gets the owned object or nullptr if there is none
+      T *Get() const
+      {
+        return p_Obj;
+      }
+
+      T &operator*() const
+      {
+        return *p_Obj;
+      }
+
+      T *operator->() const
+      {
+        return p_Obj;
+      }
+
+      explicit operator bool() const
+      {
+        return p_Obj != nullptr;
+      }
+
+    private:
+      //! The object owned by the handle
+      T *p_Obj;
+  };
+
+  /*!
+   * \class DynamicMem
+   * \brief
+   *    Creates memory in the heap that deletes automatically once it is out
+   *    of scope but can be referenced by multiple instances requiring all 
+   *    instances to dereference to be deleted.
+   *
+   *    The reference count lives within the same heap slot as the object so
+   *    creating one is a single allocation and the handle itself is only a
+   *    pointer. Copying or destroying a handle is a single increment or
+   *    decrement of the count. The count is only atomic when atomicCount is
+   *    set, use AtomicDynamicMem to share objects between threads.
+   *
+   *    DynamicWeak can reference the object without keeping it alive. The
+   *    object is destroyed once the last DynamicMem lets go but its slot is
+   *    only returned to the heap once the last DynamicWeak lets go as well.
+   *
+   * \deprecated
+   *    N/A
+   *
+   * \bug
+   *    N/A
+   */
+  template<typename T, auto heapBinding, bool atomicCount>
+  class DynamicWeak;
+
+  template<typename T, auto heapBinding = nullptr, bool atomicCount = false>
+  class DynamicMem
+  {
+    friend class DynamicWeak<T, heapBinding, atomicCount>;
+
+    public:
+      //! Creates an empty handle
+      DynamicMem()
+        : p_Block(nullptr)
+      {
+
+      }
+
+      //! Dtor which drops this handle's reference to the object
+      ~DynamicMem()
+      {
+        Deallocate();
+      }
+
+      //! Shares the object of another handle
+      DynamicMem(const DynamicMem &other)
+        : p_Block(other.p_Block)
+      {
+        if(p_Block)
+        {
+          p_Block->AddRef();
+        }
+      }
+
+      //! Takes the reference of another handle without touching the count
+      DynamicMem(DynamicMem &&other) noexcept
+        : p_Block(other.p_Block)
+      {
+        other.p_Block = nullptr;
+      }
+
+      //! Drops the current reference and shares the object of another handle
+      DynamicMem &operator=(const DynamicMem &other)
+      {
+        if(p_Block != other.p_Block)
+        {
+          if(other.p_Block)
+          {
+            other.p_Block->AddRef();
+          }
+          Deallocate();
+          p_Block = other.p_Block;
+        }
+
+        return *this;
+      }
+
+      //! Drops the current reference and takes the reference of another
+      DynamicMem &operator=(DynamicMem &&other) noexcept
+      {
+        if(this != &other)
+        {
+          Deallocate();
+          p_Block = other.p_Block;
+          other.p_Block = nullptr;
+        }
+
+        return *this;
+      }
+
+      /*!
+       * Allocates a new shared object within the given heap by constructing
+       * it from the given arguments. Only used when the heap hasn't been
+       * bound at compile time.
+       *
+       * \param in_heap
+       *    The heap that the object and its count are allocated from
+       * \param args
+       *    The arguments forwarded to the object's constructor
+       *
+       * \returns
+       *    A memory error result. Fails with a double allocation if the
+       *    handle already references an object.
+       */
+      template<typename... Args>
+      MEMERR Emplace(typename MemHeapBinding<heapBinding>::HeapType &in_heap
+          , Args&&... args)
+      {
+        static_assert(heapBinding == nullptr
+            , "The heap of a DynamicMem is already bound at compile time");
+
+        return EmplaceInto(&in_heap, std::forward<Args>(args)...);
+      }
+
+      /*!
+       * Allocates a new shared object within the heap bound at compile time
+       * by constructing it from the given arguments.
+       *
+       * \param args
+       *    The arguments forwarded to the object's constructor
+       *
+       * \returns
+       *    A memory error result.
+       */
+      template<typename... Args>
+      MEMERR EmplaceBound(Args&&... args)
+      {
+        static_assert(heapBinding != nullptr
+            , "A DynamicMem without a bound heap must be given one");
+
+        return EmplaceInto(heapBinding, std::forward<Args>(args)...);
+      }
+
+      /*!
+       * Drops this handle's reference. The object is destroyed and its slot
+       * returned to the heap once the last reference is dropped.
+       */
+      MEMERR Deallocate()
+      {
+        if(!p_Block)
+        {
+          return MEMERR_NO_ERR;
+        }
+
+        Block *p_released = p_Block;
+        p_Block = nullptr;
+
+        // Only the last reference destroys the object
+        if(!p_released->ReleaseRef())
+        {
+          return MEMERR_NO_ERR;
+        }
+
+        // Destroy the object but keep the slot while weak references exist
+        p_released->obj.~T();
+        return ReleaseWeakRef(p_released);
+      }
+
+      //! Gets the number of handles referencing the object
+      uint32_t UseCount() const
+      {
+        return p_Block ? p_Block->RefCount() : 0;
+      }
+
+      //! Gets the shared object or nullptr if there is none
+      T *Get() const
+      {
+        return p_Block ? &p_Block->obj : nullptr;
+      }
+
+      T &operator*() const
+      {
+        return p_Block->obj;
+      }
+
+      T *operator->() const
+      {
+        return &p_Block->obj;
+      }
+
+      explicit operator bool() const
+      {
+        return p_Block != nullptr;
+      }
+
+    private:
+      //! The type used for the reference count
+      using CountType = std::conditional_t<atomicCount
+        , std::atomic<uint32_t>, uint32_t>;
+
+      /*!
+       * The single heap slot holding the reference count, the heap when it
+       * is given at runtime, and the object itself.
+       */
+      struct Block : public MemHeapBinding<heapBinding>
+      {
+        Block(typename MemHeapBinding<heapBinding>::HeapType *in_heap)
+          : MemHeapBinding<heapBinding>(in_heap), refs(1), weakRefs(1)
+        {
+
+        }
+        ~Block()
+        {
+
+        }
+
+        //! Adds a reference
+        void AddRef()
+        {
+          if constexpr(atomicCount)
+          {
+            refs.fetch_add(1, std::memory_order_relaxed);
+          }
+          else
+          {
+            ++refs;
+          }
+        }
+
+        //! Drops a reference returning true if it was the last one
+        bool ReleaseRef()
+        {
+          if constexpr(atomicCount)
+          {
+            return refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+          }
+          else
+          {
+            return --refs == 0;
+          }
+        }
+
+        /*!
+         * Adds a reference only if the object is still alive. Used when a
+         * weak reference is locked so it never revives a destroyed object.
+         */
+        bool TryAddRef()
+        {
+          if constexpr(atomicCount)
+          {
+            uint32_t count = refs.load(std::memory_order_relaxed);
+            while(count)
+            {
+              if(refs.compare_exchange_weak(count, count + 1
+                    , std::memory_order_acquire, std::memory_order_relaxed))
+              {
+                return true;
+              }
+            }
+
+            return false;
+          }
+          else
+          {
+            if(!refs)
+            {
+              return false;
+            }
+
+            ++refs;
+            return true;
+          }
+        }
+
+        //! Adds a weak reference
+        void AddWeakRef()
+        {
+          if constexpr(atomicCount)
+          {
+            weakRefs.fetch_add(1, std::memory_order_relaxed);
+          }
+          else
+          {
+            ++weakRefs;
+          }
+        }
+
+        //! Drops a weak reference returning true if it was the last one
+        bool ReleaseWeakRef()
+        {
+          if constexpr(atomicCount)
+          {
+            return weakRefs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+          }
+          else
+          {
+            return --weakRefs == 0;
+          }
+        }
+
+        //! Gets the current number of references
+        uint32_t RefCount() const
+        {
+          return refs;
+        }
+
+        //! The number of handles referencing the object
+        CountType refs;
+        //! The number of weak handles plus one while the object is alive
+        CountType weakRefs;
+        //! The shared object which is constructed after the block
+        union
+        {
+          T obj;
+        };
+      };
+
+      /*!
+       * Allocates the block for a new object within the given heap and then
+       * constructs the object within it.
+       */
+      template<typename HeapT, typename... Args>
+      MEMERR EmplaceInto(HeapT *in_heap, Args&&... args)
+      {
+        if(p_Block)
+        {
+          return MEMERR_DOUBLE_ALLOC;
+        }
+        if(!in_heap)
+        {
+          return MEMERR_UNINITALIZED;
+        }
+
+        // Allocate the block holding the count
+        MEMERR error = in_heap->Emplace(p_Block, in_heap);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Construct the object within the block, giving the block back if 
+        // construction throws anything so the handle never destroys an
+        // object that was never constructed
+        try
+        {
+          new(&p_Block->obj) T(std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+          in_heap->Deallocate(p_Block);
+          p_Block = nullptr;
+          return MEMERR_UNKNOWN;
+        }
+
+        return MEMERR_NO_ERR;
+      }
+
+      /*!
+       * Drops a weak reference to a block and returns the block's slot to
+       * its heap once no references of either kind remain.
+       */
+      static MEMERR ReleaseWeakRef(Block *p_released)
+      {
+        if(!p_released->ReleaseWeakRef())
+        {
+          return MEMERR_NO_ERR;
+        }
+
+        auto *in_heap = p_released->GetHeap();
+        return in_heap->Deallocate(p_released);
+      }
+
+      //! Adopts a block whose reference has already been added
+      explicit DynamicMem(Block *in_block)
+        : p_Block(in_block)
+      {
+
+      }
+
+      //! The block shared by every handle to the object
+      Block *p_Block;
+  };
+
+  /*!
+   * \class DynamicWeak
+   * \brief
+   *    A weak reference to an object owned by DynamicMem handles. It doesn't
+   *    keep the object alive but can be locked to get a new DynamicMem if
+   *    the object still exists. Locking only touches the object's own count
+   *    so it never takes a lock.
+   *
+   * \deprecated
+   *    N/A
+   *
+   * \bug
+   *    N/A
+   */
+  template<typename T, auto heapBinding = nullptr, bool atomicCount = false>
+  class DynamicWeak
+  {
+    public:
+      //! The type of handle this weak reference can be locked into
+      using StrongType = DynamicMem<T, heapBinding, atomicCount>;
+
+      //! Creates an empty weak reference
+      DynamicWeak()
+        : p_Block(nullptr)
+      {
+
+      }
+
+      //! Creates a weak reference to the object of a handle
+      DynamicWeak(const StrongType &strong)
+        : p_Block(strong.p_Block)
+      {
+        if(p_Block)
+        {
+          p_Block->AddWeakRef();
+        }
+      }
+
+      //! Dtor which drops the weak reference
+      ~DynamicWeak()
+      {
+        Deallocate();
+      }
+
+      //! Shares the weak reference of another
+      DynamicWeak(const DynamicWeak &other)
+        : p_Block(other.p_Block)
+      {
+        if(p_Block)
+        {
+          p_Block->AddWeakRef();
+        }
+      }
+
+      //! Takes the weak reference of another
+      DynamicWeak(DynamicWeak &&other) noexcept
+        : p_Block(other.p_Block)
+      {
+        other.p_Block = nullptr;
+      }
+
+      //! Drops the current weak reference and shares another's
+      DynamicWeak &operator=(const DynamicWeak &other)
+      {
+        if(p_Block != other.p_Block)
+        {
+          if(other.p_Block)
+          {
+            other.p_Block->AddWeakRef();
+          }
+          Deallocate();
+          p_Block = other.p_Block;
+        }
+
+        return *this;
+      }
+
+      //! Drops the current weak reference and takes another's
+      DynamicWeak &operator=(DynamicWeak &&other) noexcept
+      {
+        if(this != &other)
+        {
+          Deallocate();
+          p_Block = other.p_Block;
+          other.p_Block = nullptr;
+        }
+
+        return *this;
+      }
+
+      /*!
+       * Gets a new handle to the object if it is still alive.
+       *
+       * \returns
+       *    A handle sharing the object or an empty handle if the object has
+       *    already been destroyed.
+       */
+      StrongType Lock() const
+      {
+        if(p_Block && p_Block->TryAddRef())
+        {
+          return StrongType(p_Block);
+        }
+
+        return StrongType();
+      }
+
+      //! Checks if the object has been destroyed
+      bool Expired() const
+      {
+        return !p_Block || !p_Block->RefCount();
+      }
+
+      /*!
+       * Drops the weak reference. The object's slot is returned to the heap
+       * if this was the last reference of either kind.
+       */
+      MEMERR Deallocate()
+      {
+        if(!p_Block)
+        {
+          return MEMERR_NO_ERR;
+        }
+
+        typename StrongType::Block *p_released = p_Block;
+        p_Block = nullptr;
+
+        return StrongType::ReleaseWeakRef(p_released);
+      }
+
+    private:
+      //! The block holding the object and its counts
+      typename StrongType::Block *p_Block;
+  };
+
+  //! A DynamicWeak that can be shared between threads
+  template<typename T, auto heapBinding = nullptr>
+  using AtomicDynamicWeak = DynamicWeak<T, heapBinding, true>;
+
+  //! A DynamicMem whose reference count can be shared between threads
+  template<typename T, auto heapBinding = nullptr>
+  using AtomicDynamicMem = DynamicMem<T, heapBinding, true>;
+
+#ifdef MEMSTAX_MEMORY_RESOURCE
+  /*!
+   * \class BasicMemHeapResource
+   * \brief
+   *    A std::pmr::memory_resource that allocates from a heap so that
+   *    std::pmr containers such as vector, unordered_map, and string draw
+   *    their memory from the heap's pages. Small allocations are served by
+   *    the heap's size classes and anything larger than a page is given a
+   *    large page.
+   *
+   *    The resource doesn't own the heap, which must outlive it and every
+   *    container using it. The resource is only as thread safe as its heap.
+   *    Since memory resources can't return errors a failed allocation
+   *    throws std::bad_alloc as the standard requires.
+   *
+   * \deprecated
+   *    N/A
+   *
+   * \bug
+   *    N/A
+   */
+  template<typename Policy>
+  class BasicMemHeapResource : public std::pmr::memory_resource
+  {
+    public:
+      explicit BasicMemHeapResource(BasicMemHeap<Policy> *in_heap)
+        : heap(in_heap)
+      {
+
+      }
+
+      //! Gets the heap memory is allocated from
+      BasicMemHeap<Policy> *GetHeap() const
+      {
+        return heap;
+      }
+
+    private:
+      void *do_allocate(std::size_t bytes, std::size_t alignment) override
+      {
+        void *mem = nullptr;
+        if(!heap || heap->AllocateBytes(mem, bytes, alignment) != MEMERR_NO_ERR)
+        {
+          throw std::bad_alloc();
+        }
+
+        return mem;
+      }
+
+      void do_deallocate(void *p, std::size_t bytes
+          , std::size_t alignment) override
+      {
+        heap->DeallocateBytes(p, bytes, alignment);
+      }
+
+      //! Resources are interchangeable when they share a heap
+      bool do_is_equal(const std::pmr::memory_resource &other) const 
+        noexcept override
+      {
+        const BasicMemHeapResource *otherResource 
+          = dynamic_cast<const BasicMemHeapResource*>(&other);
+
+        return otherResource && otherResource->heap == heap;
+      }
+
+      BasicMemHeap<Policy> *heap;
+  };
+
+  //! A memory resource for the default MemHeap
+  using MemHeapResource = BasicMemHeapResource<MemCallbackPolicy>;
+#endif
+
+  /*!
+   * \class Allocator
+   * \brief
+   *    A standard allocator that allocates from a heap for containers that
+   *    don't take a std::pmr memory resource. Copies and rebound copies
+   *    share the heap so node based containers allocate their nodes from
+   *    it as well.
+   *
+   *    The heap must outlive every container using the allocator. A failed
+   *    allocation throws std::bad_alloc as the standard requires.
+   *
+   * \deprecated
+   *    N/A
+   *
+   * \bug
+   *    N/A
+   */
+  template<typename T, typename Policy = MemCallbackPolicy>
+  class Allocator
+  {
+    public:
+      using value_type = T;
+
+      Allocator(BasicMemHeap<Policy> *in_heap) noexcept
+        : heap(in_heap)
+      {
+
+      }
+
+      //! Shares the heap of an allocator for another type
+      template<typename U>
+      Allocator(const Allocator<U, Policy> &other) noexcept
+        : heap(other.GetHeap())
+      {
+
+      }
+
+      //! Allocates uninitalized memory for the given number of objects
+      T *allocate(std::size_t count)
+      {
+        void *mem = nullptr;
+        if(count > SIZE_MAX / sizeof(T) || !heap 
+            || heap->AllocateBytes(mem, sizeof(T) * count, alignof(T)) 
+            != MEMERR_NO_ERR)
+        {
+          throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(mem);
+      }
+
+      //! Returns memory given by allocate to the heap
+      void deallocate(T *p, std::size_t count) noexcept
+      {
+        void *mem = p;
+        heap->DeallocateBytes(mem, sizeof(T) * count, alignof(T));
+      }
+
+      //! Gets the heap memory is allocated from
+      BasicMemHeap<Policy> *GetHeap() const noexcept
+      {
+        return heap;
+      }
+
+      //! Allocators are interchangeable when they share a heap
+      template<typename U>
+      bool operator==(const Allocator<U, Policy> &other) const noexcept
+      {
+        return heap == other.GetHeap();
+      }
+
+      template<typename U>
+      bool operator!=(const Allocator<U, Policy> &other) const noexcept
+      {
+        return heap != other.GetHeap();
+      }
+
+    private:
+      BasicMemHeap<Policy> *heap;
+  };
+
+  /*!
+   * \class StackArena
    * \brief
-   *    A helper class that helps organize and inteperet callbacks sent
-   *    by the memory system to the desired location while returning relavent
-   *    information to the user
+   *    An arena that embeds its memory within the object itself so it can
+   *    live on the call stack. Allocations bump forward through the
+   *    embedded buffer and only spill to the pages of an internal heap once
+   *    the buffer is exhausted, which is initalized on the first spill.
+   *    Short lived scratch work that fits within the buffer never touches
+   *    the global allocator.
    *
-   *    Operations included:
+   *    Deallocating the most recent allocation within the buffer gives its
+   *    memory back so the arena can be used as a stack. Any other memory
+   *    within the buffer is only given back by Reset. Spilled memory goes
+   *    back to the internal heap when it is deallocated.
    *
+   *    Every allocation is sent to the arena's callback policy. The arena
+   *    is not thread safe and can't be copied or moved since allocations
+   *    point into it.
    *
    * \deprecated
    *    N/A
@@ -350,522 +6149,705 @@ namespace Stax
    * \bug
    *    N/A
    */
-  class MemCallback
+  template<size_t arenaSize, typename Policy = MemCallbackPolicy>
+  class StackArena
   {
+    static_assert(arenaSize > 0, "StackArena requires a buffer");
+
     public:
+      //! Default page size of the heap the arena spills to
+      static inline const size_t defaultSpillPageSize = 4096;
+
       /*!
-       * Creates a new callback for memory allocation and deallocation.
-       * This can be either a general callback for all MemStax memory types
-       * or a specialized callback for a single type. Additionally the user
-       * may replace the default callback with their own callback funciton
-       * with different internal functionality (for example: if they have
-       * a sort of custom event or message handler that needs to be notified.)
+       * Creates an empty arena.
        *
-       * \param callbackFunc
-       *    A callback funciton as defined by memcallbackfunc that will recieve
-       *    messages from allocs and deallocations
+       * \param callbackClass
+       *    The callback given to the arena's policy
+       * \param in_spillPageSize
+       *    The page size of the heap used once the buffer is exhausted
+       * \param in_memFlags
+       *    Only MEMFLAGS_DISABLE_DEBUG_MSG and MEMFLAGS_OVERRIDE_DOUBLE_ALLOC
+       *    are used
        */
-      MemCallback(MemTrace *in_traceClass = nullptr
-          , memcallbackfunc in_callback = CallbackFunc
-          , MEMERR *error = nullptr)
-        : traceClass(in_traceClass), callback(in_callback)
+      explicit StackArena(MemCallback *callbackClass = nullptr
+          , const size_t &in_spillPageSize = defaultSpillPageSize
+          , const uint8_t &in_memFlags = MEMFLAGS_NONE)
+        : used(0), memFlags(in_memFlags), spillPageSize(in_spillPageSize)
+        , spilled(false)
       {
-        // Check for a valid callback function enabling callback funcitonality
-        // if it is
-        if(callback)
+        policy.Initalize(callbackClass, memFlags);
+      }
+
+      ~StackArena()
+      {
+        policy.Terminate();
+      }
+
+      StackArena(const StackArena &) = delete;
+      StackArena &operator=(const StackArena &) = delete;
+
+      /*!
+       * Allocates a value initalized object within the buffer or spills it
+       * to the internal heap if the buffer is exhausted.
+       *
+       * \param p_Obj
+       *  A pointer that will be filled with a new obj allocated on success
+       * \param in_allignment
+       *  The allignment of the object which must be a power of two
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       */
+      template<typename T>
+      MEMERR Allocate(T *&p_Obj, const size_t &in_allignment = alignof(T))
+      {
+        return EmplaceAlligned(p_Obj, in_allignment);
+      }
+
+      /*!
+       * Allocates an object by forwarding the given arguments to its
+       * constructor.
+       *
+       * \param p_Obj
+       *  A pointer that will be filled with a new obj allocated on success
+       * \param args
+       *  The arguments given to the object's constructor
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       */
+      template<typename T, typename... Args>
+      MEMERR Emplace(T *&p_Obj, Args&&... args)
+      {
+        return EmplaceAlligned(p_Obj, alignof(T), std::forward<Args>(args)...);
+      }
+
+      /*!
+       * Allocates a contiguous array of objects. Trivially constructible
+       * types are zeroed in bulk instead of being constructed one at a time.
+       *
+       * \param p_Arr
+       *  A pointer that will be filled with the first object of the array
+       * \param count
+       *  The number of objects in the array
+       * \param in_allignment
+       *  The allignment of the array which must be a power of two
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       */
+      template<typename T>
+      MEMERR AllocateArray(T *&p_Arr, const size_t &count
+          , const size_t &in_allignment = alignof(T))
+      {
+        // Arrays must hold at least one object that can be represented
+        if(!count)
         {
-          callbackInit = true;
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
         }
-        // If not then reports an error if an error address has been given
-        else if (error)
+        if(count > SIZE_MAX / sizeof(T))
         {
-          *error = MEMERR_INVALID_FUNCTION_PARAMETER;
+          return MEMERR_OUT_OF_MEM;
+        }
+
+        void *span = nullptr;
+        MEMERR error = BeginAllocate(p_Arr, sizeof(T) * count, in_allignment
+            , span);
+        if(error != MEMERR_NO_ERR)
+        {
+          return error;
+        }
+
+        // Zero trivial types in one pass since they need no constructor
+        T *first = static_cast<T*>(span);
+        if constexpr(std::is_trivially_default_constructible<T>::value)
+        {
+          std::memset(span, 0, sizeof(T) * count);
         }
+        // Otherwise construct each object in place
+        else
+        {
+          for(size_t i = 0; i < count; ++i)
+          {
+            T *p_elem = nullptr;
+            error = TryConstruct(p_elem, first + i);
+
+            // Destroy what has been constructed and give back the span
+            if(error != MEMERR_NO_ERR)
+            {
+              while(i)
+              {
+                first[--i].~T();
+              }
+              ReleaseSpan(span, sizeof(T) * count, in_allignment);
+              return error;
+            }
+          }
+        }
+        p_Arr = first;
+
+        return policy.Notify(MEMCALL_ALLOC, sizeof(T) * count, p_Arr);
       }
 
       /*!
+       * Destroys an object allocated by the arena and gives back its memory
+       * if it was spilled or is the most recent allocation within the 
+       * buffer.
+       *
+       * \param p_Obj
+       *  A pointer to an object allocated by this arena. Set to nullptr once
+       *  the object has been deallocated.
+       * \param in_allignment
+       *  The allignment the object was allocated with
        *
+       * \returns
+       *  A MEMERR indicating if any errors occured during deallocation
        */
-      ~MemCallback()
+      template<typename T>
+      MEMERR Deallocate(T *&p_Obj, const size_t &in_allignment = alignof(T))
       {
-        if(callback)
-        {
-          callbackInit = false;
-        }
+        return DeallocateArray(p_Obj, 1, in_allignment);
       }
 
       /*!
-       * Performs a callback but calling the classes callback funciton that
-       * the user has provided. The user is required to give a msg but can
-       * leave the size blank if they wish to ignore it and it will print
-       * out a 0 by default
+       * Destroys every object of an array allocated by the arena and gives
+       * back its memory the same way as Deallocate. The count and allignment
+       * must match what the array was allocated with.
        *
-       * \param msg
-       *    The callback message being sent to the callback manager
-       * \param memSize
-       *    The size of the object being allocated into memory
+       * \param p_Arr
+       *  A pointer to the first object of the array. Set to nullptr once
+       *  the array has been deallocated.
+       * \param count
+       *  The number of objects in the array
+       * \param in_allignment
+       *  The allignment the array was allocated with
        *
        * \returns
-       *    An error message for error checking
+       *  A MEMERR indicating if any errors occured during deallocation
        */
-      MEMERR PerformCallback(const MEMCALL &msg, const size_t &memSize = 0)
+      template<typename T>
+      MEMERR DeallocateArray(T *&p_Arr, const size_t &count
+          , const size_t &in_allignment = alignof(T))
       {
-        if(callbackInit)
+        // Make sure there is an array to deallocate
+        if(!p_Arr || !count)
         {
-          return callback(msg, memSize, traceClass);
+          const MEMERR error = policy.Notify(MEMCALL_INVALID_MEM
+              , sizeof(T) * count);
+
+          return (error != MEMERR_NO_ERR) ? error : MEMERR_INVALID_MEM;
         }
 
-        return MEMERR_UNINITALIZED;
+        policy.Notify(MEMCALL_DEALLOC, sizeof(T) * count, p_Arr);
+
+        // Destroy each object in reverse order of construction
+        if constexpr(!std::is_trivially_destructible<T>::value)
+        {
+          for(size_t i = count; i; --i)
+          {
+            p_Arr[i - 1].~T();
+          }
+        }
+
+        ReleaseSpan(p_Arr, sizeof(T) * count, in_allignment);
+        p_Arr = nullptr;
+
+        return MEMERR_NO_ERR;
       }
-  
+
       /*!
-       * Returns a pointer to the callback function
+       * Gives back every allocation at once, emptying the buffer and 
+       * releasing the pages of the internal heap. Objects are not destroyed.
        */
-      memcallbackfunc GetMemCallback()
+      void Reset()
       {
-        if(!callback)
+        used = 0;
+        if(spilled)
         {
-          // TODO: Add and replace with memory exceptions
-          return nullptr;
+          spillHeap.TerminateHeapMem();
+          spilled = false;
         }
+      }
 
-        return callback;
+      //! Checks if the memory given lies within the arena's buffer
+      bool InBuffer(const void *mem) const
+      {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(mem);
+        const uintptr_t base = reinterpret_cast<uintptr_t>(buffer);
+
+        return address >= base && address < base + arenaSize;
       }
 
+      //! Gets the number of bytes used within the buffer
+      size_t GetBufferUsed() const
+      {
+        return used;
+      }
 
+      //! Wether any allocation has spilled out of the buffer since the
+      //! arena was created or reset
+      bool HasSpilled() const
+      {
+        return spilled;
+      }
 
-    private:
-      // TODO: figure out if we want seperate alloc and dealloc counters for 
-      //  each callback class. If we so then we need some sort of way to 
-      //  differentiate which one we want. Most likley a struct that each
-      //  class passes into the callback func with a bunch of data that can
-      //  be added to allowing you to derive it and add relavant info :)
-      static MEMERR CallbackFunc(const MEMCALL &msg, const size_t &memSize
-          , MemTrace *traceCall)
+      Policy &GetPolicy()
       {
-        // Create a string to input a trace message into
-        std::string traceMsg;
+        return policy;
+      }
 
-        // Check what callback is being performed
-        switch(msg)
+    private:
+      //! Finds memory for an object then constructs it with the arguments
+      template<typename T, typename... Args>
+      MEMERR EmplaceAlligned(T *&p_Obj, const size_t &in_allignment
+          , Args&&... args)
+      {
+        void *block = nullptr;
+        MEMERR error = BeginAllocate(p_Obj, sizeof(T), in_allignment, block);
+        if(error != MEMERR_NO_ERR)
         {
-          case MEMCALL_ALLOC:
-            ++allocs;
-            memInUse += memSize;
-            traceMsg = "Allocating Memory of size: " 
-              + std::to_string(memSize);
-            break;
-          case MEMCALL_DEALLOC:
-            ++deallocs;
-            memInUse -= memSize;
-            traceMsg = "Deallocating Memory of size: " 
-              + std::to_string(memSize);
-            break;
-          case MEMCALL_MEM_ERR:
-            traceMsg = "Error Allocating Memory of size: "
-              + std::to_string(memSize);
-            break;
-          case MEMCALL_INVALID_MEM:
-            traceMsg = "Error Accessing Memory of size: "
-              + std::to_string(memSize);
+          return error;
         }
 
-        // If there is a trace message then give the trace log 
-        // the callbacks message
-        if(traceCall)
+        error = TryConstruct(p_Obj, block, std::forward<Args>(args)...);
+        if(error != MEMERR_NO_ERR)
         {
-          traceCall->LogMessage(traceMsg);
+          ReleaseSpan(block, sizeof(T), in_allignment);
+          return error;
         }
 
-        return MEMERR_NO_ERR;
+        return policy.Notify(MEMCALL_ALLOC, sizeof(T), p_Obj);
       }
-      static inline uint32_t allocs = 0;
-      static inline uint32_t deallocs = 0;
-      static inline size_t memInUse = 0;
-
-      bool callbackInit;
-      MemTrace *traceClass;
-      memcallbackfunc callback;
-  };
 
-  /*!
-   * Creates raw memory in the heap that is not directly handled by the class
-   *
-   * with default allocation space of 1024 bytes for objects allocated
-   */
-  class MemHeap 
-  {
-    public:
-      MemHeap()
-        : heapInitalized(false), memFlags(0), callback(nullptr)
+      /*!
+       * Bumps alligned memory from the buffer or spills to the internal heap
+       * once the buffer can't fit the memory.
+       */
+      MEMERR BeginAllocate(const void *p_Mem, const size_t &memSize
+          , const size_t &in_allignment, void *&span)
       {
+        // Check for a double allocation unless it has been disabled
+        if(!(memFlags & MEMFLAGS_OVERRIDE_DOUBLE_ALLOC) && p_Mem)
+        {
+          return MEMERR_DOUBLE_ALLOC;
+        }
 
-      }
-      ~MemHeap()
-      {
+        // Bump allocation relies on the allignment being a power of two
+        if(!in_allignment || (in_allignment & (in_allignment - 1)))
+        {
+          return MEMERR_INVALID_FUNCTION_PARAMETER;
+        }
 
-      }
+        // Allign the next free byte of the buffer and check the memory fits
+        const uintptr_t base = reinterpret_cast<uintptr_t>(buffer);
+        const size_t offset = ((base + used + in_allignment - 1) 
+            & ~(in_allignment - 1)) - base;
+        if(offset <= arenaSize && memSize <= arenaSize - offset)
+        {
+          span = buffer + offset;
+          used = offset + memSize;
 
-      // Default vairables as static consts
-      static inline const size_t defaultPageSize = 1024;
-      static inline const size_t defaultNumOfPages = 10;
-      static inline const size_t defaultAllignment = 8;
+          return MEMERR_NO_ERR;
+        }
 
-      // TODO: on initalization have it take in a callback funciton which 
-      //  tracks allocations, deallocations, and object allocation size.
-      //  Maybe a templatized class (based on Heap, Static, and Dynamic)
-      //  This allows us to track allocations seperate from the memory
-      //  allocation object and have it be override more easily by the
-      //  user in case they wanted to do something else and minimize overhead.
-      MEMERR InitalizeHeapMem(const size_t &in_pageSize = defaultPageSize 
-          , const size_t &in_numOfPages = defaultNumOfPages
-          , const size_t &in_allignment = defaultAllignment
-          , MemCallback *callbackClass = nullptr)
-      {
-        // Create an error tracking object
+        // Only touch the internal heap once the buffer is exhausted
         MEMERR error = MEMERR_NO_ERR;
+        if(!spilled)
+        {
+          error = spillHeap.InitalizeHeapMem(spillPageSize
+              , BasicMemHeap<NullPolicy>::defaultNumOfPages
+              , BasicMemHeap<NullPolicy>::defaultAllignment);
+          spilled = (error == MEMERR_NO_ERR);
+        }
+        if(error == MEMERR_NO_ERR)
+        {
+          error = spillHeap.AllocateBytes(span, memSize, in_allignment);
+        }
 
-        // Initalize all objects for the page
-        // Set number of pages to 0 to make sure it is initalized
-        numOfPages = 0;
-        // Update the page size and number of pages
-        maxPageSize = in_pageSize;
-        maxPages = in_numOfPages;
-        // Update the allignment of each object
-        allignment = in_allignment;
-
-        // Check to see if the callback given is valid and assign it 
-        if(callbackClass)
+        // Let the callback know memory couldn't be found
+        if(error != MEMERR_NO_ERR)
         {
-          callback = callbackClass;
+          const MEMERR callbackError = policy.Notify(MEMCALL_MEM_ERR, memSize);
+
+          return (callbackError != MEMERR_NO_ERR) ? callbackError : error;
         }
 
-        // Allocate the pointers for the page
-        error = TryAllocate<uint8_t*>(pages, numOfPages);
-        // Allocate the pointers for the page sizes
-        error = TryAllocate<size_t>(pageSizes, maxPages);
+        return MEMERR_NO_ERR;
+      }
 
-        // Set all page sizes to 0 to initalize them
-        for(size_t i = 0 ; i < maxPages; ++i)
+      /*!
+       * Gives back memory from BeginAllocate. Memory within the buffer is
+       * only given back when it is the most recent allocation.
+       */
+      void ReleaseSpan(void *span, const size_t &memSize
+          , const size_t &in_allignment)
+      {
+        if(InBuffer(span))
         {
-          pageSizes[i] = 0;
+          uint8_t *mem = static_cast<uint8_t*>(span);
+          if(mem + memSize == buffer + used)
+          {
+            used = mem - buffer;
+          }
         }
-
-        // Return the error if something failed
-        if(error != MEMERR_NO_ERR)
+        else
         {
-          return error;
+          spillHeap.DeallocateBytes(span, memSize, in_allignment);
         }
+      }
 
-        // Allocate the first page
-        error = AllocatePage();
+      /*!
+       * Constructs an object at the given address, reporting a constructor
+       * that throws as an error.
+       */
+      template<typename T, typename... Args>
+      MEMERR TryConstruct(T *&p_obj, void *addressPtr, Args&&... args)
+      {
+        try
+        {
+          p_obj = new(addressPtr) T(std::forward<Args>(args)...);
+        }
+        catch(const std::bad_alloc &e)
+        {
+          // Notify the callback and report that memory ran out
+          const MEMERR error = policy.Notify(MEMCALL_MEM_ERR, sizeof(T));
 
-        // Return the error if something failed
-        if(error != MEMERR_NO_ERR)
+          return (error != MEMERR_NO_ERR) ? error : MEMERR_OUT_OF_MEM;
+        }
+        catch(const std::exception &e)
         {
-          return error;
+          // Notify the callback and report that the constructor failed
+          const MEMERR error = policy.Notify(MEMCALL_MEM_ERR, sizeof(T));
+
+          return (error != MEMERR_NO_ERR) ? error : MEMERR_UNKNOWN;
         }
-        
-        // Turn on the heap to enable allocation
-        heapInitalized = true;
 
         return MEMERR_NO_ERR;
       }
 
-      MEMERR TerminateHeapMem()
+      //! The memory allocations are bumped from before spilling
+      alignas(std::max_align_t) uint8_t buffer[arenaSize];
+      //! The number of bytes used within the buffer
+      size_t used;
+      uint8_t memFlags;
+      //! Receives every callback message the arena sends
+      Policy policy;
+      //! The page size of the internal heap
+      size_t spillPageSize;
+      //! Wether the internal heap has been initalized
+      bool spilled;
+      //! Holds the allocations that didn't fit within the buffer
+      BasicMemHeap<NullPolicy> spillHeap;
+  };
+
+  /*!
+   * \class MemPool
+   * \brief
+   *    A pool of objects of a single type. Every slot has the same size and
+   *    allignment so allocating and deallocating are a single pointer pop
+   *    or push of an intrusive free list threaded through the freed slots,
+   *    without looking up a size class.
+   *
+   *    Freed slots are reused first, the most recently freed one first,
+   *    since it is the most likely to still be in the cache. Only when none
+   *    are free is a new slot carved out of the current chunk allocated
+   *    from a heap, in address order, so objects allocated together start
+   *    out next to each other in memory. Chunks are only returned to the
+   *    heap when the pool is released or destroyed.
+   *
+   *    The heap is bound the same way as StaticMem. Callbacks are compiled
+   *    out by the default NullPolicy and sent for every object once another
+   *    policy is chosen and given a callback with SetCallback. The pool is
+   *    not thread safe.
+   *
+   * \deprecated
+   *    N/A
+   *
+   * \bug
+   *    N/A
+   */
+  template<typename T, auto heapBinding = nullptr, typename Policy = NullPolicy>
+  class MemPool : private MemHeapBinding<heapBinding>
+  {
+    public:
+      //! Default number of slots in each chunk
+      static inline const size_t defaultSlotsPerChunk = 64;
+
+      /*!
+       * Creates an empty pool for a heap bound at compile time.
+       */
+      explicit MemPool(const size_t &in_slotsPerChunk = defaultSlotsPerChunk)
+        : MemHeapBinding<heapBinding>(), freeSlots(nullptr), chunks(nullptr)
+        , nextSlot(nullptr), slotsEnd(nullptr), numOfLive(0), numOfChunks(0)
+        , slotsPerChunk(in_slotsPerChunk ? in_slotsPerChunk : 1), chunkSize(0)
       {
-        // Turn off the heap
-        heapInitalized = false;
+        policy.Initalize(nullptr, MEMFLAGS_NONE);
+      }
 
-        // Remove access to the callback
-        callback = nullptr;
+      /*!
+       * Creates an empty pool that allocates chunks from the given heap.
+       */
+      explicit MemPool(typename MemHeapBinding<heapBinding>::HeapType &in_heap
+          , const size_t &in_slotsPerChunk = defaultSlotsPerChunk)
+        : MemHeapBinding<heapBinding>(&in_heap), freeSlots(nullptr)
+        , chunks(nullptr), nextSlot(nullptr), slotsEnd(nullptr), numOfLive(0)
+        , numOfChunks(0), slotsPerChunk(in_slotsPerChunk ? in_slotsPerChunk : 1)
+        , chunkSize(0)
+      {
+        static_assert(heapBinding == nullptr
+            , "The heap of a MemPool is already bound at compile time");
+        policy.Initalize(nullptr, MEMFLAGS_NONE);
+      }
 
-        return MEMERR_NO_ERR;
+      //! Dtor which returns every chunk to the heap
+      ~MemPool()
+      {
+        ReleasePool();
+        policy.Terminate();
       }
 
+      MemPool(const MemPool &) = delete;
+      MemPool &operator=(const MemPool &) = delete;
+
       /*!
-       * Takes in a pointer and creates a raw pointer that is returned
-       * to the user to be handled. Additionally keeps track of allocs and
-       * double allocation and returns errors properly in case an issue
-       * occurs.
+       * Gives the pool's policy a callback to send messages to.
        *
-       * \param p_Obj
-       *  A pointer that will be filled with a new obj allocated on success
-       * \param callbackFun
-       *  A pointer to a callback function that is not required but will
-       *  send a message to the given callback func if provided. Callback
-       *  may keep track of allcoations as well but class will continue
-       *  to keep personal count.
+       * \param callbackClass
+       *    The callback given to the policy
+       * \param memFlags
+       *    Flags such as MEMFLAGS_DISABLE_DEBUG_MSG given to the policy
        *
-       * An example of the callback funciton as it will be taken by 
-       * the function.
+       * \returns
+       *    A memory error result.
+       */
+      MEMERR SetCallback(MemCallback *callbackClass
+          , const uint8_t &memFlags = MEMFLAGS_NONE)
+      {
+        return policy.Initalize(callbackClass, memFlags);
+      }
+
+      /*!
+       * Allocates an object by forwarding the given arguments to its
+       * constructor within a free slot.
        *
-       * TODO: PROVIDE BETTER EXAMPLE
-       *  void (*)(const std::string &string)
+       * \param p_Obj
+       *  A pointer that will be filled with a new obj allocated on success
+       * \param args
+       *  The arguments given to the object's constructor
        *
        * \returns 
        *  A MEMERR indicating if any errors occured during allocation
-       *  which helps the use avoid doing unnecessary error checking
-       *  and bloating their own code/program.
        */
-      template<typename T>
-      MEMERR Allocate(T *&p_Obj)
-      { 
-        // Create a variable to track errors
-        MEMERR error = MEMERR_NO_ERR;
-
-        // Get the total object size within the page
-        size_t objPageSize = sizeof(T) + (sizeof(T) % allignment);
-
-        // Create an object to find out which page to allocate to
-        size_t currentPage = numOfPages;
-
-        // Check all pages for space
-        for(size_t i = 0 ; i < numOfPages; ++i)
+      template<typename... Args>
+      MEMERR Emplace(T *&p_Obj, Args&&... args)
+      {
+        // Check for a double allocation to avoid losing the object
+        if(p_Obj)
         {
-          // If we find that a page has enough size remaining then set
-          // the current page to that page and break from the loop
-          if(objPageSize < (maxPageSize - pageSizes[i]))
-          {
-            currentPage = i;
-            break;
-          }
+          return MEMERR_DOUBLE_ALLOC;
         }
 
-        // If the current page is the same or greater than the number of 
-        // pages that means that a page with enoguh size was not found so 
-        // we will attempt to allocate a new one
-        if(currentPage >= numOfPages)
+        // Pop a freed slot, otherwise take the next unused slot of the
+        // newest chunk
+        void *slot = freeSlots;
+        if(slot)
         {
-          error = AllocatePage();
-          
-          // Check to see if there was an error and return if there was
-          if(error != MEMERR_NO_ERR)
+          freeSlots = *static_cast<void**>(slot);
+        }
+        else
+        {
+          if(nextSlot == slotsEnd)
           {
-            return error;
+            const MEMERR error = AllocateChunk();
+            if(error != MEMERR_NO_ERR)
+            {
+              return error;
+            }
           }
+          slot = nextSlot;
+          nextSlot += slotSize;
         }
 
-        // Check for a double allocation to avoid allocating over an 
-        //  already allocated object so that we don't risk floating memory
-        //  unless the user has specifically disabled it
-        if(!(memFlags & MEMFLAGS_OVERRIDE_DOUBLE_ALLOC) && p_Obj)
+        try
         {
-          return MEMERR_DOUBLE_ALLOC;
+          p_Obj = new(slot) T(std::forward<Args>(args)...);
         }
-
-        // Attempt to allocate the object
-        error = TryAllocate<T>(p_Obj, 1
-            , pages[numOfPages - 1] + pageSizes[numOfPages - 1]);
-
-        // Check if any errors have occured and return if they have
-        if(error != MEMERR_NO_ERR)
+        catch(...)
         {
-          return error;
-        }
-
-        // Update the page size if we have successfully allocated
-        pageSizes[numOfPages - 1] += objPageSize; 
+          // Give the slot back and report that the constructor failed
+          PushFreeSlot(slot);
+          const MEMERR error = policy.Notify(MEMCALL_MEM_ERR, sizeof(T));
 
-        // Check to see if debug messages are disabled... if not then notify the user
-        //  we have allocated a new object by calling their desired callback
-        if(!(memFlags & MEMFLAGS_DISABLE_DEBUG_MSG) && callback)
-        {
-          error = callback->PerformCallback(MEMCALL_ALLOC, sizeof(T));
+          return (error != MEMERR_NO_ERR) ? error : MEMERR_UNKNOWN;
         }
+        ++numOfLive;
 
-        return error;
+        return policy.Notify(MEMCALL_ALLOC, sizeof(T), p_Obj);
       }
 
+      /*!
+       * Allocates a value initalized object within a free slot.
+       *
+       * \param p_Obj
+       *  A pointer that will be filled with a new obj allocated on success
+       *
+       * \returns 
+       *  A MEMERR indicating if any errors occured during allocation
+       */
+      MEMERR Allocate(T *&p_Obj)
+      {
+        return Emplace(p_Obj);
+      }
 
-      // Need a good way to track deallocations
-      template<typename T>
+      /*!
+       * Destroys an object allocated by the pool and pushes its slot onto
+       * the free list.
+       *
+       * \param p_Obj
+       *  A pointer to an object allocated by this pool. Set to nullptr once
+       *  the object has been deallocated.
+       *
+       * \returns
+       *  A MEMERR indicating if any errors occured during deallocation
+       */
       MEMERR Deallocate(T *&p_Obj)
       {
-        // Initalize to avoid a non-error passing an error
-        MEMERR error = MEMERR_NO_ERR;
-
         if(!p_Obj)
         {
+          const MEMERR error = policy.Notify(MEMCALL_INVALID_MEM, sizeof(T));
 
-          // If there was an error with calling new then call the callback
-          // funciton if avaliable to print a message then return
-          // an out of mem error to the user so they are able to respond
-          // appropriatly
-          if(callback)
-          {
-            error = callback->PerformCallback(MEMCALL_INVALID_MEM, sizeof(T));
-          }
-
-          // Make sure no errors occured during callback... 
-          // if there was an error then return the error to user :)
-          if(error != MEMERR_NO_ERR)
-          {
-            return error;
-          }
-
-          return MEMERR_INVALID_MEM;
+          return (error != MEMERR_NO_ERR) ? error : MEMERR_INVALID_MEM;
         }
 
-        // If there is a callback and debug messages are on
-        // then perform a callback message
-        if(!(memFlags & MEMFLAGS_DISABLE_DEBUG_MSG) && callback)
-        {
-          error = callback->PerformCallback(MEMCALL_DEALLOC, sizeof(T));
-        }
+        policy.Notify(MEMCALL_DEALLOC, sizeof(T), p_Obj);
 
-        // Delete the memory given by the user
-        delete p_Obj;
+        p_Obj->~T();
+        PushFreeSlot(p_Obj);
+        --numOfLive;
         p_Obj = nullptr;
 
         return MEMERR_NO_ERR;
       }
 
-    private:
-      bool heapInitalized;
-      uint8_t memFlags;
-      MemCallback *callback;
-      size_t allignment;
-      size_t numOfPages;
-      size_t maxPages;
-      size_t maxPageSize;
-      size_t* pageSizes;
-      uint8_t** pages;
-
-      template<typename T>
-      MEMERR TryAllocate(T *&p_obj, const size_t sizeOverride = 1
-          , void *addressPtr = nullptr)
+      /*!
+       * Returns every chunk to the heap at once. Objects still allocated
+       * are not destroyed and must not be used afterwards.
+       */
+      void ReleasePool()
       {
-        // Attempt to allocate a new object of designated size at
-        // given address if provided 
-        try
+        while(chunks)
         {
-          if(addressPtr)
-          {
-            if(sizeOverride > 1)
-            {
-              p_obj = new(addressPtr) T[sizeOverride];
-            }
-            else
-            {
-              p_obj = new(addressPtr) T;
-            }
-          }
-          else
-          {
-            if(sizeOverride > 1)
-            {
-              p_obj = new T[sizeOverride];
-            }
-            else
-            {
-              p_obj = new T;
-            }
-          }
+          void *chunk = chunks;
+          chunks = chunks->nextChunk;
+          this->GetHeap()->DeallocateBytes(chunk, chunkSize, chunkAllignment);
         }
-        catch(const std::bad_alloc &e)
-        {
-          // Initalize to avoid a non-error passing an error
-          MEMERR error = MEMERR_NO_ERR;
 
-          // If there was an error with calling new then call the callback
-          // funciton if avaliable to print a message then return
-          // an out of mem error to the user so they are able to respond
-          // appropriatly
-          if(callback)
-          {
-            error = callback->PerformCallback(MEMCALL_MEM_ERR
-                , sizeof(T) * sizeOverride);
-          }
+        freeSlots = nullptr;
+        nextSlot = nullptr;
+        slotsEnd = nullptr;
+        numOfLive = 0;
+        numOfChunks = 0;
+      }
 
-          // Make sure no errors occured during callback... 
-          // if there was an error then return the error to user :)
-          if(error != MEMERR_NO_ERR)
-          {
-            return error;
-          }
+      //! Gets the number of objects currently allocated
+      size_t GetNumOfLive() const
+      {
+        return numOfLive;
+      }
 
-          return MEMERR_OUT_OF_MEM;
-        }
-        catch(const std::exception &e)
-        {
-          // Initalize to avoid a non-error passing an error
-          MEMERR error = MEMERR_NO_ERR;
+      //! Gets the number of chunks allocated from the heap
+      size_t GetNumOfChunks() const
+      {
+        return numOfChunks;
+      }
 
-          // If there was an error with calling new then call the callback
-          // funciton if avaliable to print a message then return
-          // an out of mem error to the user so they are able to respond
-          // appropriatly
-          if(callback)
-          {
-            error = callback->PerformCallback(MEMCALL_MEM_ERR
-                , sizeof(T) * sizeOverride);
-          }
+      Policy &GetPolicy()
+      {
+        return policy;
+      }
 
-          // Make sure no errors occured during callback... 
-          // if there was an error then return the error to user :)
-          if(error != MEMERR_NO_ERR)
-          {
-            return error;
-          }
+    private:
+      //! Starts each chunk to link it to the previously allocated chunk
+      struct ChunkHeader
+      {
+        ChunkHeader *nextChunk;
+      };
 
-          return MEMERR_UNKNOWN;
-        }
+      //! Slots must be able to hold a free list link once freed
+      static constexpr size_t slotAllignment = (alignof(T) > alignof(void*))
+        ? alignof(T) : alignof(void*);
+      static constexpr size_t slotSize = (((sizeof(T) > sizeof(void*))
+          ? sizeof(T) : sizeof(void*)) + slotAllignment - 1)
+        & ~(slotAllignment - 1);
+      //! Slots start after the chunk header at their allignment
+      static constexpr size_t slotsOffset = (sizeof(ChunkHeader)
+          + slotAllignment - 1) & ~(slotAllignment - 1);
+      static constexpr size_t chunkAllignment 
+        = (slotAllignment > alignof(ChunkHeader)) 
+        ? slotAllignment : alignof(ChunkHeader);
 
-        return MEMERR_NO_ERR;
+      //! Pushes a slot onto the free list
+      void PushFreeSlot(void *slot)
+      {
+        *static_cast<void**>(slot) = freeSlots;
+        freeSlots = slot;
       }
 
-      MEMERR AllocatePage()
+      //! Allocates a new chunk from the heap and bumps from its slots
+      MEMERR AllocateChunk()
       {
-        // Make sure we can allocate another page!
-        if(++numOfPages > maxPages)
+        if(!this->GetHeap())
         {
-          --numOfPages;
-          return MEMERR_OUT_OF_MEM;
+          return MEMERR_UNINITALIZED;
         }
 
-        // Attempt to allocate a new page
-        MEMERR error = TryAllocate<uint8_t>(pages[numOfPages - 1], maxPageSize); 
+        if(slotsPerChunk > (SIZE_MAX - slotsOffset) / slotSize)
+        {
+          return MEMERR_OUT_OF_MEM;
+        }
+        chunkSize = slotsOffset + slotSize * slotsPerChunk;
 
-        // If something failed undo the incrementing of pages
+        void *chunk = nullptr;
+        MEMERR error = this->GetHeap()->AllocateBytes(chunk, chunkSize
+            , chunkAllignment);
         if(error != MEMERR_NO_ERR)
         {
-          --numOfPages;
-        }
-        
-        // Return whatever message try allocate returned
-        return error;
-      }
-  };
+          const MEMERR callbackError = policy.Notify(MEMCALL_MEM_ERR
+              , chunkSize);
 
-  /*!
-   * Creates memory in the heap that deletes automatically once it is out
-   *  of scope.
-   */
-  template<typename T>
-  class StaticMem 
-  {
-    public:
-      StaticMem();
-      ~StaticMem();
+          return (callbackError != MEMERR_NO_ERR) ? callbackError : error;
+        }
 
-    private:
+        // Link the chunk so it can be returned when the pool is released
+        ChunkHeader *header = static_cast<ChunkHeader*>(chunk);
+        header->nextChunk = chunks;
+        chunks = header;
+        ++numOfChunks;
 
-  };
+        nextSlot = static_cast<uint8_t*>(chunk) + slotsOffset;
+        slotsEnd = nextSlot + slotSize * slotsPerChunk;
 
-  /*!
-   * Creates memory in the heap that deletes automatically once it is out of
-   *  scope but can be referenced by multiple instances requiring all 
-   *  instances to dereference to be deleted
-   */
-  template<typename T>
-  class DynamicMem
-  {
-    public:
-      DynamicMem();
-      ~DynamicMem();
+        return MEMERR_NO_ERR;
+      }
 
-    private:
+      //! Receives every callback message the pool sends
+      Policy policy;
+      //! Head of the intrusive free list of freed slots
+      void *freeSlots;
+      //! The most recently allocated chunk
+      ChunkHeader *chunks;
+      //! The next slot of the newest chunk that has never been used
+      uint8_t *nextSlot;
+      //! The end of the newest chunk's slots
+      uint8_t *slotsEnd;
+      //! The number of objects currently allocated
+      size_t numOfLive;
+      //! The number of chunks allocated
+      size_t numOfChunks;
+      //! The number of slots within each chunk
+      size_t slotsPerChunk;
+      //! The number of bytes allocated for each chunk
+      size_t chunkSize;
   };
 }
 
@@ -0,0 +1,384 @@
+/*!
+ * \file    memstaxbench.cpp
+ *
+ * \details
+ *    A set of microbenchmarks comparing MemHeap against new and delete.
+ *    Each benchmark reports the nanoseconds per operation and the number
+ *    of allocations per second so that performance regressions can be
+ *    caught between releases. Should be built with optimizations through
+ *    the makefile's bench target.
+ *
+ *    Usage: MemStax_Bench.exe [scale]
+ *      Scale multiplies the number of operations of every benchmark.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "MemStax.h"
+
+using namespace std;
+using namespace Stax;
+
+//! A heap that ignores its callbacks so only allocation is measured
+using BenchHeap = BasicMemHeap<NullPolicy>;
+
+//! A fixed size object used by most benchmarks
+struct BenchObj
+{
+  uint64_t values[8];
+};
+
+//! Number of objects kept alive at once by the churn benchmarks
+static const size_t windowSize = 1024;
+//! Largest size allocated by the mixed size benchmark
+static const size_t maxMixedSize = 512;
+
+//! A heap bound at compile time by the shared handle benchmark
+static BenchHeap handleHeap;
+//! Keeps the reads of the shared handle benchmark from being optimized out
+static atomic<uint64_t> handleSink(0);
+
+static void ReportBench(const char *name, const char *strategy
+    , const size_t &numOfOps, const size_t &numOfAllocs
+    , const chrono::steady_clock::duration &duration);
+static void Bench_FixedChurn(const size_t &numOfOps);
+static void Bench_MixedSizes(const size_t &numOfOps);
+static void Bench_CrossThreadFree(const size_t &numOfOps);
+static void Bench_ArenaRewind(const size_t &numOfOps);
+static void Bench_HandleCopies(const size_t &numOfOps);
+
+int main(int argc, char** argv)
+{
+  size_t scale = 1;
+  if(argc > 1)
+  {
+    scale = strtoull(argv[1], nullptr, 10);
+    scale = scale ? scale : 1;
+  }
+
+  cout << left << setw(22) << "Benchmark" << setw(22) << "Strategy"
+    << right << setw(12) << "ns/op" << setw(16) << "allocs/sec" << '\n';
+
+  // Allocate and free objects of one size while keeping a window alive
+  Bench_FixedChurn(scale * 4000000);
+  // The same with sizes spread over many size classes
+  Bench_MixedSizes(scale * 4000000);
+  // One thread allocates while another frees
+  Bench_CrossThreadFree(scale * 2000000);
+  // Fill an arena and release it all at once
+  Bench_ArenaRewind(scale * 4000000);
+  // Copy shared handles between threads
+  Bench_HandleCopies(scale * 4000000);
+
+  return 0;
+}
+
+//! Prints a row of results for a single benchmark and strategy
+void ReportBench(const char *name, const char *strategy
+    , const size_t &numOfOps, const size_t &numOfAllocs
+    , const chrono::steady_clock::duration &duration)
+{
+  const double seconds = chrono::duration<double>(duration).count();
+  const double nsPerOp = seconds * 1e9 / numOfOps;
+  const double allocsPerSec = seconds > 0 ? numOfAllocs / seconds : 0;
+
+  cout << left << setw(22) << name << setw(22) << strategy << right
+    << fixed << setprecision(2) << setw(12) << nsPerOp
+    << setprecision(0) << setw(16) << allocsPerSec << '\n';
+}
+
+//! A small random number generator so every strategy sees the same sizes
+static uint32_t NextRandom(uint32_t &state)
+{
+  state = state * 1664525u + 1013904223u;
+  return state >> 8;
+}
+
+void Bench_FixedChurn(const size_t &numOfOps)
+{
+  vector<BenchObj*> window(windowSize, nullptr);
+
+  {
+    const auto start = chrono::steady_clock::now();
+    for(size_t i = 0; i < numOfOps; ++i)
+    {
+      BenchObj *&slot = window[i % windowSize];
+      delete slot;
+      slot = new BenchObj;
+      slot->values[0] = i;
+    }
+    const auto end = chrono::steady_clock::now();
+    for(BenchObj *&slot : window)
+    {
+      delete slot;
+      slot = nullptr;
+    }
+    ReportBench("fixed churn", "new/delete", numOfOps, numOfOps, end - start);
+  }
+
+  const uint8_t heapModes[] = { MEMFLAGS_NONE, MEMFLAGS_THREAD_SAFE
+    , MEMFLAGS_SLAB };
+  const char *heapNames[] = { "MemHeap", "MemHeap thread safe"
+    , "MemHeap slab" };
+  for(size_t mode = 0; mode < sizeof(heapModes); ++mode)
+  {
+    BenchHeap heap;
+    heap.InitalizeHeapMem(4096, MemHeap::defaultNumOfPages
+        , MemHeap::defaultAllignment, nullptr, heapModes[mode]);
+
+    const auto start = chrono::steady_clock::now();
+    for(size_t i = 0; i < numOfOps; ++i)
+    {
+      BenchObj *&slot = window[i % windowSize];
+      if(slot)
+      {
+        heap.Deallocate(slot);
+      }
+      heap.AllocateUninitalized(slot);
+      slot->values[0] = i;
+    }
+    const auto end = chrono::steady_clock::now();
+    for(BenchObj *&slot : window)
+    {
+      heap.Deallocate(slot);
+    }
+    ReportBench("fixed churn", heapNames[mode], numOfOps, numOfOps
+        , end - start);
+  }
+}
+
+void Bench_MixedSizes(const size_t &numOfOps)
+{
+  vector<uint8_t*> window(windowSize, nullptr);
+  vector<size_t> windowSizes(windowSize, 0);
+
+  {
+    uint32_t random = 1;
+    const auto start = chrono::steady_clock::now();
+    for(size_t i = 0; i < numOfOps; ++i)
+    {
+      const size_t slot = i % windowSize;
+      delete[] window[slot];
+      windowSizes[slot] = NextRandom(random) % maxMixedSize + 1;
+      window[slot] = new uint8_t[windowSizes[slot]];
+      window[slot][0] = static_cast<uint8_t>(i);
+    }
+    const auto end = chrono::steady_clock::now();
+    for(uint8_t *&slot : window)
+    {
+      delete[] slot;
+      slot = nullptr;
+    }
+    ReportBench("mixed sizes", "new/delete", numOfOps, numOfOps, end - start);
+  }
+
+  const uint8_t heapModes[] = { MEMFLAGS_NONE, MEMFLAGS_SLAB
+    , MEMFLAGS_BUDDY };
+  const char *heapNames[] = { "MemHeap", "MemHeap slab", "MemHeap buddy" };
+  for(size_t mode = 0; mode < sizeof(heapModes); ++mode)
+  {
+    BenchHeap heap;
+    heap.InitalizeHeapMem(4096, MemHeap::defaultNumOfPages
+        , MemHeap::defaultAllignment, nullptr, heapModes[mode]);
+
+    uint32_t random = 1;
+    const auto start = chrono::steady_clock::now();
+    for(size_t i = 0; i < numOfOps; ++i)
+    {
+      const size_t slot = i % windowSize;
+      if(window[slot])
+      {
+        heap.DeallocateArray(window[slot], windowSizes[slot]);
+      }
+      windowSizes[slot] = NextRandom(random) % maxMixedSize + 1;
+      heap.AllocateArrayUninitalized(window[slot], windowSizes[slot]);
+      window[slot][0] = static_cast<uint8_t>(i);
+    }
+    const auto end = chrono::steady_clock::now();
+    for(size_t slot = 0; slot < windowSize; ++slot)
+    {
+      heap.DeallocateArray(window[slot], windowSizes[slot]);
+    }
+    ReportBench("mixed sizes", heapNames[mode], numOfOps, numOfOps
+        , end - start);
+  }
+}
+
+/*!
+ * Runs a producer that allocates objects and hands them to a consumer
+ * thread which frees them through a single producer single consumer ring.
+ */
+template<typename AllocFunc, typename FreeFunc>
+static chrono::steady_clock::duration RunProducerConsumer(
+    const size_t &numOfOps, AllocFunc &&allocFunc, FreeFunc &&freeFunc)
+{
+  vector<atomic<BenchObj*>> ring(windowSize);
+  for(atomic<BenchObj*> &slot : ring)
+  {
+    slot.store(nullptr, memory_order_relaxed);
+  }
+
+  const auto start = chrono::steady_clock::now();
+  thread consumer([&ring, &numOfOps, &freeFunc]()
+  {
+    for(size_t i = 0; i < numOfOps; ++i)
+    {
+      atomic<BenchObj*> &slot = ring[i % windowSize];
+      BenchObj *obj = nullptr;
+      while(!(obj = slot.load(memory_order_acquire)))
+      {
+        this_thread::yield();
+      }
+      slot.store(nullptr, memory_order_relaxed);
+      freeFunc(obj);
+    }
+  });
+
+  for(size_t i = 0; i < numOfOps; ++i)
+  {
+    BenchObj *obj = allocFunc();
+    obj->values[0] = i;
+
+    atomic<BenchObj*> &slot = ring[i % windowSize];
+    while(slot.load(memory_order_relaxed))
+    {
+      this_thread::yield();
+    }
+    slot.store(obj, memory_order_release);
+  }
+  consumer.join();
+
+  return chrono::steady_clock::now() - start;
+}
+
+void Bench_CrossThreadFree(const size_t &numOfOps)
+{
+  ReportBench("cross thread free", "new/delete", numOfOps, numOfOps
+      , RunProducerConsumer(numOfOps, []()
+        {
+          return new BenchObj;
+        }
+        , [](BenchObj *obj)
+        {
+          delete obj;
+        }));
+
+  BenchHeap heap;
+  heap.InitalizeHeapMem(4096, MemHeap::defaultNumOfPages
+      , MemHeap::defaultAllignment, nullptr, MEMFLAGS_THREAD_SAFE);
+  ReportBench("cross thread free", "MemHeap thread safe", numOfOps, numOfOps
+      , RunProducerConsumer(numOfOps, [&heap]()
+        {
+          BenchObj *obj = nullptr;
+          heap.AllocateUninitalized(obj);
+          return obj;
+        }
+        , [&heap](BenchObj *obj)
+        {
+          heap.Deallocate(obj);
+        }));
+}
+
+void Bench_ArenaRewind(const size_t &numOfOps)
+{
+  vector<BenchObj*> objs(windowSize, nullptr);
+
+  {
+    const auto start = chrono::steady_clock::now();
+    for(size_t i = 0; i < numOfOps; i += windowSize)
+    {
+      for(size_t j = 0; j < windowSize; ++j)
+      {
+        objs[j] = new BenchObj;
+        objs[j]->values[0] = j;
+      }
+      for(size_t j = 0; j < windowSize; ++j)
+      {
+        delete objs[j];
+      }
+    }
+    ReportBench("arena rewind", "new/delete", numOfOps, numOfOps
+        , chrono::steady_clock::now() - start);
+  }
+
+  {
+    BenchHeap heap;
+    heap.InitalizeHeapMem(64 * 1024, MemHeap::defaultNumOfPages
+        , MemHeap::defaultAllignment, nullptr, MEMFLAGS_MONOTONIC);
+    const BenchHeap::MemMarker marker = heap.GetMarker();
+
+    const auto start = chrono::steady_clock::now();
+    for(size_t i = 0; i < numOfOps; i += windowSize)
+    {
+      for(size_t j = 0; j < windowSize; ++j)
+      {
+        BenchObj *obj = nullptr;
+        heap.AllocateUninitalized(obj);
+        obj->values[0] = j;
+        objs[j] = obj;
+      }
+      heap.RewindTo(marker);
+    }
+    ReportBench("arena rewind", "MemHeap monotonic", numOfOps, numOfOps
+        , chrono::steady_clock::now() - start);
+  }
+}
+
+/*!
+ * Copies a shared handle back and forth from several threads at once.
+ * Nothing is allocated so allocs/sec is left at zero.
+ */
+template<typename Handle>
+static chrono::steady_clock::duration RunHandleCopies(const size_t &numOfOps
+    , const Handle &handle)
+{
+  const size_t numOfThreads = 4;
+  const size_t opsPerThread = numOfOps / numOfThreads;
+
+  const auto start = chrono::steady_clock::now();
+  vector<thread> threads;
+  for(size_t i = 0; i < numOfThreads; ++i)
+  {
+    threads.emplace_back([&handle, &opsPerThread]()
+    {
+      // Only read through the copies since every thread shares the object
+      uint64_t sum = 0;
+      for(size_t j = 0; j < opsPerThread; ++j)
+      {
+        Handle copy = handle;
+        sum += copy->values[0];
+      }
+      handleSink.fetch_add(sum, memory_order_relaxed);
+    });
+  }
+  for(thread &t : threads)
+  {
+    t.join();
+  }
+
+  return chrono::steady_clock::now() - start;
+}
+
+void Bench_HandleCopies(const size_t &numOfOps)
+{
+  const shared_ptr<BenchObj> sharedPtr = make_shared<BenchObj>();
+  ReportBench("shared handle copies", "std::shared_ptr", numOfOps, 0
+      , RunHandleCopies(numOfOps, sharedPtr));
+
+  handleHeap.InitalizeHeapMem();
+  {
+    AtomicDynamicMem<BenchObj, &handleHeap> dynamicMem;
+    dynamicMem.EmplaceBound();
+    ReportBench("shared handle copies", "AtomicDynamicMem", numOfOps, 0
+        , RunHandleCopies(numOfOps, dynamicMem));
+  }
+  handleHeap.TerminateHeapMem();
+}
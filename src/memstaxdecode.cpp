@@ -0,0 +1,167 @@
+/*!
+ * \file    memstaxdecode.cpp
+ *
+ * \details
+ *    A command line tool that decodes a binary trace written by MemTrace
+ *    with MEMTRACEFORMAT_BINARY. Prints a summary of the trace and can
+ *    optionally print every record as text.
+ *
+ *    Usage: MemStax_Decode.exe <trace file> [-v]
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include "MemStax.h"
+
+using namespace std;
+using namespace Stax;
+
+static const char *EventName(const uint8_t &type);
+
+int main(int argc, char** argv)
+{
+  if(argc < 2)
+  {
+    cerr << "Usage: " << argv[0] << " <trace file> [-v]" << endl;
+    return 1;
+  }
+
+  // Print every record when asked to be verbose
+  const bool verbose = (argc > 2 && strcmp(argv[2], "-v") == 0);
+
+  ifstream file(argv[1], ios::binary);
+  if(!file.is_open())
+  {
+    cerr << "Unable to open trace file: " << argv[1] << endl;
+    return 1;
+  }
+  const vector<char> bytes((istreambuf_iterator<char>(file))
+      , istreambuf_iterator<char>());
+
+  MemTraceReader reader(reinterpret_cast<const uint8_t*>(bytes.data())
+      , bytes.size());
+
+  // Totals gathered while reading
+  uint64_t numOfRecords = 0;
+  uint64_t numOfEvents[MEMCALL_MEM_LIMIT + 1] = {};
+  uint64_t numOfMsgs = 0;
+  uint64_t bytesAllocated = 0;
+  uint64_t bytesDeallocated = 0;
+  uint64_t memInUse = 0;
+  uint64_t peakMemInUse = 0;
+  uint64_t firstTimestamp = 0;
+  uint64_t lastTimestamp = 0;
+  map<uint32_t, uint64_t> eventsPerThread;
+
+  MemTraceRecord record;
+  MEMERR error = MEMERR_NO_ERR;
+  while(!reader.AtEnd())
+  {
+    error = reader.Next(record);
+    if(error != MEMERR_NO_ERR)
+    {
+      break;
+    }
+    ++numOfRecords;
+
+    if(record.type == MemTraceRecord::textRecord)
+    {
+      ++numOfMsgs;
+      if(verbose)
+      {
+        cout << "MSG     " << record.msg << '\n';
+      }
+      continue;
+    }
+
+    ++numOfEvents[record.type];
+    ++eventsPerThread[record.threadId];
+    if(!firstTimestamp)
+    {
+      firstTimestamp = record.timestamp;
+    }
+    lastTimestamp = record.timestamp;
+
+    // Follow the memory in use to find its peak
+    if(record.type == MEMCALL_ALLOC)
+    {
+      bytesAllocated += record.memSize;
+      memInUse += record.memSize;
+      if(memInUse > peakMemInUse)
+      {
+        peakMemInUse = memInUse;
+      }
+    }
+    else if(record.type == MEMCALL_DEALLOC)
+    {
+      bytesDeallocated += record.memSize;
+      memInUse -= (record.memSize < memInUse) ? record.memSize : memInUse;
+    }
+
+    if(verbose)
+    {
+      cout << EventName(record.type) << " +"
+        << (record.timestamp - firstTimestamp) << "ns thread "
+        << record.threadId << " size " << record.memSize << " address 0x"
+        << hex << record.address << dec << '\n';
+    }
+  }
+
+  // Report where the trace stopped making sense
+  if(error == MEMERR_INVALID_FILE)
+  {
+    cerr << "Not a binary trace or an unknown version: " << argv[1] << endl;
+    return 1;
+  }
+  if(error != MEMERR_NO_ERR)
+  {
+    cerr << "Trace is corrupt after " << numOfRecords << " records" << endl;
+  }
+
+  cout << "Records:           " << numOfRecords << '\n'
+    << "Bytes per record:  "
+    << (numOfRecords ? double(bytes.size()) / numOfRecords : 0.0) << '\n'
+    << "Duration:          " << (lastTimestamp - firstTimestamp) / 1000000.0
+    << " ms\n";
+  for(uint8_t type = MEMCALL_ALLOC; type <= MEMCALL_MEM_LIMIT; ++type)
+  {
+    cout << EventName(type) << "           " << numOfEvents[type] << '\n';
+  }
+  cout << "Messages:          " << numOfMsgs << '\n'
+    << "Bytes allocated:   " << bytesAllocated << '\n'
+    << "Bytes deallocated: " << bytesDeallocated << '\n'
+    << "Peak mem in use:   " << peakMemInUse << '\n'
+    << "Threads:           " << eventsPerThread.size() << '\n';
+  for(const pair<const uint32_t, uint64_t> &thread : eventsPerThread)
+  {
+    cout << "  Thread " << thread.first << ": " << thread.second
+      << " events\n";
+  }
+
+  return (error == MEMERR_NO_ERR) ? 0 : 1;
+}
+
+// Gets a fixed width name for an event type
+const char *EventName(const uint8_t &type)
+{
+  switch(type)
+  {
+    case MEMCALL_ALLOC:
+      return "ALLOC  ";
+    case MEMCALL_DEALLOC:
+      return "DEALLOC";
+    case MEMCALL_MEM_ERR:
+      return "MEMERR ";
+    case MEMCALL_INVALID_MEM:
+      return "INVALID";
+    case MEMCALL_MEM_LIMIT:
+      return "LIMIT  ";
+  }
+
+  return "UNKNOWN";
+}
@@ -0,0 +1,352 @@
+/*!
+ * \file    memstaxreplay.cpp
+ *
+ * \details
+ *    A command line tool that replays the allocations and deallocations of
+ *    a binary trace written by MemTrace against different allocation
+ *    strategies. Reports the throughput, the p50 and p99 latency of each
+ *    operation, and the peak resident memory of every strategy so heap
+ *    parameters can be tuned against real workloads.
+ *
+ *    Events are replayed in the order they were traced on a single thread.
+ *    Addresses are used to match each deallocation to its allocation so
+ *    events traced without an address are allocated but never freed.
+ *
+ *    Usage: MemStax_Replay.exe <trace file> [-p pageSize] [-a allignment]
+ *      [-r repeats]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+#include "MemStax.h"
+
+// Each strategy runs in its own process so its peak memory is its own
+#if defined(__unix__) || defined(__APPLE__)
+#define MEMSTAX_REPLAY_FORK 1
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace Stax;
+
+/*!
+ * A single operation of the replay. Allocations fill the slot they name and
+ * deallocations empty it.
+ */
+struct ReplayOp
+{
+  bool isAlloc;
+  size_t slot;
+  size_t size;
+};
+
+//! Parameters given on the command line
+struct ReplayConfig
+{
+  size_t pageSize = MemHeap::defaultPageSize;
+  size_t allignment = MemHeap::defaultAllignment;
+  size_t repeats = 1;
+};
+
+//! A heap that ignores its callbacks so only allocation is measured
+using ReplayHeap = BasicMemHeap<NullPolicy>;
+
+static MEMERR LoadOps(const char *tracePath, vector<ReplayOp> &ops
+    , size_t &numOfSlots);
+template<typename StartFunc, typename AllocFunc, typename FreeFunc>
+static void RunStrategy(const char *name, const vector<ReplayOp> &ops
+    , const size_t &numOfSlots, const ReplayConfig &config
+    , StartFunc &&startFunc, AllocFunc &&allocFunc, FreeFunc &&freeFunc);
+static void ReportResults(const char *name, const size_t &numOfOps
+    , vector<uint32_t> &latencies, const double &seconds);
+static long PeakRSSKb();
+
+int main(int argc, char** argv)
+{
+  if(argc < 2)
+  {
+    cerr << "Usage: " << argv[0] << " <trace file> [-p pageSize]"
+      << " [-a allignment] [-r repeats]" << endl;
+    return 1;
+  }
+
+  ReplayConfig config;
+  for(int i = 2; i + 1 < argc; i += 2)
+  {
+    const size_t value = strtoull(argv[i + 1], nullptr, 10);
+    if(strcmp(argv[i], "-p") == 0)
+    {
+      config.pageSize = value;
+    }
+    else if(strcmp(argv[i], "-a") == 0)
+    {
+      config.allignment = value;
+    }
+    else if(strcmp(argv[i], "-r") == 0)
+    {
+      config.repeats = value ? value : 1;
+    }
+  }
+
+  vector<ReplayOp> ops;
+  size_t numOfSlots = 0;
+  if(LoadOps(argv[1], ops, numOfSlots) != MEMERR_NO_ERR)
+  {
+    cerr << "Unable to read binary trace: " << argv[1] << endl;
+    return 1;
+  }
+
+  cout << "Replaying " << ops.size() << " operations over " << numOfSlots
+    << " allocations, page size " << config.pageSize << ", allignment "
+    << config.allignment << ", " << config.repeats << " repeats\n\n";
+
+  // The system allocator as a baseline
+  RunStrategy("malloc", ops, numOfSlots, config
+      , []()
+      {
+        return true;
+      }
+      , [](const size_t &size) -> void*
+      {
+        return malloc(size);
+      }
+      , [](void *mem, const size_t &)
+      {
+        free(mem);
+      });
+
+  // Each MemHeap mode gets a fresh heap for every repeat
+  const uint8_t heapModes[] = { MEMFLAGS_NONE, MEMFLAGS_THREAD_SAFE
+    , MEMFLAGS_MONOTONIC };
+  const char *heapNames[] = { "MemHeap", "MemHeap thread safe"
+    , "MemHeap monotonic" };
+  for(size_t mode = 0; mode < sizeof(heapModes); ++mode)
+  {
+    ReplayHeap heap;
+    RunStrategy(heapNames[mode], ops, numOfSlots, config
+        , [&heap, &config, &heapModes, mode]()
+        {
+          return heap.InitalizeHeapMem(config.pageSize
+              , MemHeap::defaultNumOfPages, config.allignment, nullptr
+              , heapModes[mode]) == MEMERR_NO_ERR;
+        }
+        , [&heap, &config](const size_t &size) -> void*
+        {
+          uint8_t *mem = nullptr;
+          heap.AllocateArrayUninitalized(mem, size, config.allignment);
+          return mem;
+        }
+        , [&heap, &config](void *mem, const size_t &size)
+        {
+          uint8_t *p_mem = static_cast<uint8_t*>(mem);
+          heap.DeallocateArray(p_mem, size, config.allignment);
+        });
+  }
+
+  return 0;
+}
+
+/*!
+ * Reads the allocation events of a trace into replay operations. Each
+ * allocation gets its own slot and a deallocation empties the slot of the
+ * live allocation at its address.
+ */
+MEMERR LoadOps(const char *tracePath, vector<ReplayOp> &ops
+    , size_t &numOfSlots)
+{
+  ifstream file(tracePath, ios::binary);
+  if(!file.is_open())
+  {
+    return MEMERR_INVALID_FILE;
+  }
+  const vector<char> bytes((istreambuf_iterator<char>(file))
+      , istreambuf_iterator<char>());
+
+  MemTraceReader reader(reinterpret_cast<const uint8_t*>(bytes.data())
+      , bytes.size());
+  unordered_map<uint64_t, size_t> liveSlots;
+  MemTraceRecord record;
+  MEMERR error = MEMERR_NO_ERR;
+  while((error = reader.Next(record)) == MEMERR_NO_ERR)
+  {
+    if(record.type == MEMCALL_ALLOC)
+    {
+      const size_t size = record.memSize ? record.memSize : 1;
+      ops.push_back({ true, numOfSlots, size });
+      if(record.address)
+      {
+        liveSlots[record.address] = numOfSlots;
+      }
+      ++numOfSlots;
+    }
+    else if(record.type == MEMCALL_DEALLOC)
+    {
+      // Deallocations of memory allocated before the trace started are
+      // skipped
+      const auto slot = liveSlots.find(record.address);
+      if(slot != liveSlots.end())
+      {
+        ops.push_back({ false, slot->second, 0 });
+        liveSlots.erase(slot);
+      }
+    }
+  }
+
+  // Reaching the end is the only way reading should stop
+  return (error == MEMERR_INVALID_MEM) ? MEMERR_NO_ERR : error;
+}
+
+/*!
+ * Replays the operations with the given allocation and free functions,
+ * timing every operation. The start function sets up the strategy before
+ * every repeat without being timed. Runs in a child process when possible
+ * so that the peak memory reported belongs to the strategy alone.
+ */
+template<typename StartFunc, typename AllocFunc, typename FreeFunc>
+void RunStrategy(const char *name, const vector<ReplayOp> &ops
+    , const size_t &numOfSlots, const ReplayConfig &config
+    , StartFunc &&startFunc, AllocFunc &&allocFunc, FreeFunc &&freeFunc)
+{
+  cout.flush();
+#ifdef MEMSTAX_REPLAY_FORK
+  const pid_t child = fork();
+  if(child > 0)
+  {
+    int status = 0;
+    waitpid(child, &status, 0);
+    return;
+  }
+#endif
+
+  vector<void*> slots(numOfSlots, nullptr);
+  vector<size_t> slotSizes(numOfSlots, 0);
+  vector<uint32_t> latencies;
+  latencies.reserve(ops.size() * config.repeats);
+  size_t numOfFailed = 0;
+  chrono::duration<double> totalTime(0);
+
+  for(size_t repeat = 0; repeat < config.repeats; ++repeat)
+  {
+    if(!startFunc())
+    {
+      cout << name << ": unable to start with these parameters\n\n";
+      break;
+    }
+
+    const auto replayStart = chrono::steady_clock::now();
+    for(const ReplayOp &op : ops)
+    {
+      const auto opStart = chrono::steady_clock::now();
+      if(op.isAlloc)
+      {
+        void *mem = allocFunc(op.size);
+        slots[op.slot] = mem;
+        slotSizes[op.slot] = op.size;
+
+        // Touch the memory so it counts towards the resident memory
+        if(mem)
+        {
+          *static_cast<volatile uint8_t*>(mem) = 0;
+        }
+        else
+        {
+          ++numOfFailed;
+        }
+      }
+      else if(slots[op.slot])
+      {
+        freeFunc(slots[op.slot], slotSizes[op.slot]);
+        slots[op.slot] = nullptr;
+      }
+      latencies.push_back(static_cast<uint32_t>(
+            chrono::duration_cast<chrono::nanoseconds>(
+              chrono::steady_clock::now() - opStart).count()));
+    }
+
+    // Free whatever the trace left allocated so the next repeat starts
+    // with an empty heap
+    for(size_t slot = 0; slot < numOfSlots; ++slot)
+    {
+      if(slots[slot])
+      {
+        freeFunc(slots[slot], slotSizes[slot]);
+        slots[slot] = nullptr;
+      }
+    }
+    totalTime += chrono::steady_clock::now() - replayStart;
+  }
+
+  if(!latencies.empty())
+  {
+    ReportResults(name, latencies.size(), latencies, totalTime.count());
+    if(numOfFailed)
+    {
+      cout << "  Failed allocations: " << numOfFailed << '\n';
+    }
+    cout << '\n';
+  }
+  cout.flush();
+
+#ifdef MEMSTAX_REPLAY_FORK
+  _exit(0);
+#endif
+}
+
+//! Prints the throughput, latency percentiles, and peak memory of a run
+void ReportResults(const char *name, const size_t &numOfOps
+    , vector<uint32_t> &latencies, const double &seconds)
+{
+  cout << name << '\n';
+  cout << "  Throughput: "
+    << (seconds > 0 ? numOfOps / seconds / 1000000.0 : 0.0) << " Mops/s\n";
+
+  if(!latencies.empty())
+  {
+    const size_t p50 = latencies.size() / 2;
+    const size_t p99 = latencies.size() * 99 / 100;
+    nth_element(latencies.begin(), latencies.begin() + p50, latencies.end());
+    cout << "  p50 latency: " << latencies[p50] << " ns\n";
+    nth_element(latencies.begin(), latencies.begin() + p99, latencies.end());
+    cout << "  p99 latency: " << latencies[p99] << " ns\n";
+  }
+
+  const long peakRSS = PeakRSSKb();
+  if(peakRSS >= 0)
+  {
+    cout << "  Peak RSS: " << peakRSS << " KiB\n";
+  }
+  else
+  {
+    cout << "  Peak RSS: unavaliable\n";
+  }
+}
+
+//! Gets the peak resident memory of the process in KiB or -1 if unknown
+long PeakRSSKb()
+{
+#ifdef MEMSTAX_REPLAY_FORK
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return -1;
+  }
+#ifdef __APPLE__
+  // macOS reports bytes instead of KiB
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return -1;
+#endif
+}
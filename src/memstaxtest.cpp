@@ -12,6 +12,14 @@
 
 #include <cstring>
 #include <assert.h>
+#include <algorithm>
+#include <iterator>
+#include <atomic>
+#include <list>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "MemStax.h"
 
@@ -24,12 +32,50 @@ static void UnitTest_MemTrace_CustomTrace();
 static void UnitTest_MemTrace_FileNoClear();
 static void UnitTest_MemTrace_FileDifferent();
 static void UnitTest_MemTrace_CheckGetFile();
+static void UnitTest_MemTrace_AsyncWriter();
+static void UnitTest_MemTrace_AsyncDrop();
+static void UnitTest_MemTrace_Binary();
+static void UnitTest_MemTrace_MappedFile();
 
 static void UnitTest_MemCallback_SendConsoleCallbackMsg();
+static void UnitTest_MemCallback_Stats();
+static void UnitTest_MemCallback_TraceBuffer();
 
 static void UnitTest_MemHeap_TestDefaults();
+static void UnitTest_MemHeap_ReuseFreedBlock();
+static void UnitTest_MemHeap_PagePlacement();
+static void UnitTest_MemHeap_GrowPageDirectory();
+static void UnitTest_MemHeap_Allignment();
+static void UnitTest_MemHeap_Emplace();
+static void UnitTest_MemHeap_Array();
+static void UnitTest_MemHeap_MonotonicRewind();
+static void UnitTest_MemHeap_ThreadSafe();
+static void UnitTest_MemHeap_RemoteFree();
+static void UnitTest_MemHeap_CallbackPolicy();
+static void UnitTest_MemHeap_Allocators();
+static void UnitTest_MemHeap_Slab();
+static void UnitTest_MemHeap_Buddy();
+
+static void UnitTest_StaticMem_Ownership();
+
+static void UnitTest_StackArena_Spill();
+
+static void UnitTest_MemPool_FreeList();
+
+static void UnitTest_DynamicMem_SharedOwnership();
+static void UnitTest_DynamicMem_WeakReference();
 
 static MEMERR CustomMemTrace(const string &, fstream *);
+static MEMERR RecordMemTrace(const string &, fstream *);
+
+// The last message recorded by RecordMemTrace and where it was stored
+static string recordedMsg;
+static const char *recordedMsgData = nullptr;
+
+// A heap bound at compile time by memory handles
+static MemHeap globalHeap;
+// A heap with a different callback policy bound by memory handles
+static BasicMemHeap<CountingPolicy<>> countingHeap;
 
 int main(int argc, char** argv)
 {
@@ -61,18 +107,82 @@ int main(int argc, char** argv)
     // , and writting with log again with seperate asserts. Since they relate
     // closly and may cause odd interactions with one another test all 3.
     UnitTest_MemTrace_CheckGetFile();
+    // Test writing messages from many threads through the writer thread
+    UnitTest_MemTrace_AsyncWriter();
+    // Test dropping messages while the ring buffer is full
+    UnitTest_MemTrace_AsyncDrop();
+    // Test writing binary records and reading them back
+    UnitTest_MemTrace_Binary();
+    // Test writing to a memory mapped trace file that grows by chunks
+    UnitTest_MemTrace_MappedFile();
   }
 
   if(strncmp(argv[0], "MemCallback", sizeof("MemCallback")) || runAllTests)
   {
     // Test sending a trace message to the console with the callback class
     UnitTest_MemCallback_SendConsoleCallbackMsg();
+    // Test that counters from many threads add up in a stats snapshot
+    UnitTest_MemCallback_Stats();
+    // Test that trace messages are formatted into a reused buffer
+    UnitTest_MemCallback_TraceBuffer();
   }
   
   if(strncmp(argv[0], "MemHeap", sizeof("MemHeap")) || runAllTests)
   {
     // Test the defaults of allocating and deallocating a standard type
     UnitTest_MemHeap_TestDefaults();
+    // Test that freed blocks are handed out again by their size class
+    UnitTest_MemHeap_ReuseFreedBlock();
+    // Test that objects are placed within the page that has room for them
+    UnitTest_MemHeap_PagePlacement();
+    // Test that the heap keeps growing past its starting number of pages
+    UnitTest_MemHeap_GrowPageDirectory();
+    // Test that over-alligned objects are placed at alligned addresses
+    UnitTest_MemHeap_Allignment();
+    // Test constructing objects in place and allocating without construction
+    UnitTest_MemHeap_Emplace();
+    // Test allocating contiguous arrays within pages and large pages
+    UnitTest_MemHeap_Array();
+    // Test rewinding a monotonic heap to markers and resetting it
+    UnitTest_MemHeap_MonotonicRewind();
+    // Test sharing a heap between threads through their local caches
+    UnitTest_MemHeap_ThreadSafe();
+    // Test that blocks freed by another thread return to their owner
+    UnitTest_MemHeap_RemoteFree();
+    // Test heaps that count or ignore their callbacks at compile time
+    UnitTest_MemHeap_CallbackPolicy();
+    // Test standard containers allocating through a heap
+    UnitTest_MemHeap_Allocators();
+    // Test packing objects into slabs and walking the live ones
+    UnitTest_MemHeap_Slab();
+    // Test splitting and merging power of two blocks of a buddy heap
+    UnitTest_MemHeap_Buddy();
+  }
+
+  if(strncmp(argv[0], "StaticMem", sizeof("StaticMem")) || runAllTests)
+  {
+    // Test that a static handle owns, moves, and returns its object
+    UnitTest_StaticMem_Ownership();
+  }
+
+  if(strncmp(argv[0], "StackArena", sizeof("StackArena")) || runAllTests)
+  {
+    // Test allocating from the embedded buffer and spilling past it
+    UnitTest_StackArena_Spill();
+  }
+
+  if(strncmp(argv[0], "MemPool", sizeof("MemPool")) || runAllTests)
+  {
+    // Test that pool slots are contiguous and reused through the free list
+    UnitTest_MemPool_FreeList();
+  }
+
+  if(strncmp(argv[0], "DynamicMem", sizeof("DynamicMem")) || runAllTests)
+  {
+    // Test that shared handles keep their object alive until the last one
+    UnitTest_DynamicMem_SharedOwnership();
+    // Test that weak references don't keep their object alive
+    UnitTest_DynamicMem_WeakReference();
   }
 
   return 0;
@@ -197,6 +307,434 @@ void UnitTest_MemTrace_CheckGetFile()
   assert(error == MEMERR_NO_ERR);
 }
 
+void UnitTest_MemTrace_AsyncWriter()
+{
+  MEMERR error;
+  MemTrace trace("./log/AsyncTrace.txt", true, &error);
+  assert(error == MEMERR_NO_ERR);
+
+  // Use a small ring so producers have to wait for the writer
+  error = trace.StartAsyncWriter(64, MEMTRACEFULL_BLOCK);
+  assert(error == MEMERR_NO_ERR);
+  error = trace.StartAsyncWriter();
+  assert(error == MEMERR_DOUBLE_ALLOC);
+
+  const size_t numOfThreads = 4;
+  const size_t numOfMsgs = 500;
+  // A message long enough to span several slots
+  const string longMsg(300, 'x');
+
+  vector<thread> threads;
+  for(size_t i = 0; i < numOfThreads; ++i)
+  {
+    threads.emplace_back([&trace, &longMsg]()
+    {
+      for(size_t j = 0; j < numOfMsgs; ++j)
+      {
+        MEMERR logError = trace.LogMessage((j % 50) ? "Async Trace Log" 
+            : longMsg);
+        assert(logError == MEMERR_NO_ERR);
+        (void)logError;
+      }
+    });
+  }
+  for(thread &t : threads)
+  {
+    t.join();
+  }
+
+  // Every message logged is in the file once flushed
+  error = trace.Flush();
+  assert(error == MEMERR_NO_ERR);
+
+  ifstream file("./log/AsyncTrace.txt");
+  string line;
+  size_t numOfLines = 0;
+  size_t numOfLongLines = 0;
+  while(getline(file, line))
+  {
+    assert(line == "Async Trace Log" || line == longMsg);
+    numOfLongLines += (line == longMsg);
+    ++numOfLines;
+  }
+  assert(numOfLines == numOfThreads * numOfMsgs);
+  assert(numOfLongLines == numOfThreads * numOfMsgs / 50);
+  assert(trace.GetDroppedMsgs() == 0);
+}
+
+void UnitTest_MemTrace_AsyncDrop()
+{
+  MEMERR error;
+  MemTrace trace("./log/AsyncTrace2.txt", true, &error);
+  assert(error == MEMERR_NO_ERR);
+
+  error = trace.StartAsyncWriter(4, MEMTRACEFULL_DROP);
+  assert(error == MEMERR_NO_ERR);
+
+  // Messages either make it to the file or are counted as dropped
+  const size_t numOfMsgs = 1000;
+  size_t numOfDropped = 0;
+  for(size_t i = 0; i < numOfMsgs; ++i)
+  {
+    if(trace.LogMessage("Dropped Trace Log") == MEMERR_OUT_OF_MEM)
+    {
+      ++numOfDropped;
+    }
+  }
+
+  // Stopping the writer writes out the rest of the ring
+  trace.StopAsyncWriter();
+  trace.Flush();
+
+  ifstream file("./log/AsyncTrace2.txt");
+  string line;
+  size_t numOfLines = 0;
+  while(getline(file, line))
+  {
+    ++numOfLines;
+  }
+  assert(trace.GetDroppedMsgs() == numOfDropped);
+  assert(numOfLines + numOfDropped == numOfMsgs);
+}
+
+void UnitTest_MemTrace_Binary()
+{
+  MEMERR error;
+  MemTrace trace("./log/BinaryTrace.bin", true, &error);
+  assert(error == MEMERR_NO_ERR);
+  error = trace.SetFormat(MEMTRACEFORMAT_BINARY);
+  assert(error == MEMERR_NO_ERR);
+
+  // Trace a heap's events along with their addresses
+  MemCallback callback(&trace);
+  MemHeap heap;
+  error = heap.InitalizeHeapMem(MemHeap::defaultPageSize
+      , MemHeap::defaultNumOfPages, MemHeap::defaultAllignment, &callback);
+  assert(error == MEMERR_NO_ERR);
+
+  int *p_int = nullptr;
+  heap.Allocate(p_int);
+  const uint64_t address = reinterpret_cast<uintptr_t>(p_int);
+  heap.Deallocate(p_int);
+  trace.LogMessage("Binary Trace Log");
+
+  // Formatted event messages can be logged as text records
+  trace.LogMessage(MemTrace::FormatEventMsg(MEMCALL_ALLOC, 4));
+
+  // Records logged through the writer thread are encoded the same way
+  error = trace.StartAsyncWriter();
+  assert(error == MEMERR_NO_ERR);
+  for(size_t i = 0; i < 100; ++i)
+  {
+    trace.LogEvent(MEMCALL_ALLOC, i, reinterpret_cast<void*>(i * 16));
+  }
+  trace.StopAsyncWriter();
+  trace.Flush();
+
+  ifstream file("./log/BinaryTrace.bin", ios::binary);
+  const vector<char> bytes((istreambuf_iterator<char>(file))
+      , istreambuf_iterator<char>());
+  MemTraceReader reader(reinterpret_cast<const uint8_t*>(bytes.data())
+      , bytes.size());
+
+  MemTraceRecord record;
+  error = reader.Next(record);
+  assert(error == MEMERR_NO_ERR);
+  assert(record.type == MEMCALL_ALLOC);
+  assert(record.memSize == sizeof(int));
+  assert(record.address == address);
+  const uint64_t allocTime = record.timestamp;
+
+  error = reader.Next(record);
+  assert(error == MEMERR_NO_ERR);
+  assert(record.type == MEMCALL_DEALLOC);
+  assert(record.address == address);
+  assert(record.timestamp >= allocTime);
+
+  error = reader.Next(record);
+  assert(error == MEMERR_NO_ERR);
+  assert(record.type == MemTraceRecord::textRecord);
+  assert(record.msg == "Binary Trace Log");
+
+  error = reader.Next(record);
+  assert(error == MEMERR_NO_ERR);
+  assert(record.type == MemTraceRecord::textRecord);
+  assert(record.msg == "Allocating Memory of size: 4");
+
+  for(size_t i = 0; i < 100; ++i)
+  {
+    error = reader.Next(record);
+    assert(error == MEMERR_NO_ERR);
+    assert(record.memSize == i);
+    assert(record.address == i * 16);
+  }
+  assert(reader.AtEnd());
+  assert(reader.Next(record) == MEMERR_INVALID_MEM);
+
+  // Records are far smaller than their text messages
+  assert(bytes.size() < 100 * 10);
+
+  // Threads logging without the writer thread still write records that
+  // decode to the addresses they logged
+  MemTrace threadedTrace("./log/ThreadedBinaryTrace.bin", true, &error);
+  assert(error == MEMERR_NO_ERR);
+  threadedTrace.ClearFile();
+  error = threadedTrace.SetFormat(MEMTRACEFORMAT_BINARY);
+  assert(error == MEMERR_NO_ERR);
+
+  const size_t numThreads = 4;
+  const size_t numEvents = 1000;
+  vector<thread> threads;
+  for(size_t t = 0; t < numThreads; ++t)
+  {
+    threads.emplace_back([&threadedTrace, t]()
+    {
+      for(size_t i = 0; i < numEvents; ++i)
+      {
+        threadedTrace.LogEvent(MEMCALL_ALLOC, t
+            , reinterpret_cast<void*>((t << 20) | (i * 16)));
+      }
+    });
+  }
+  for(thread &worker : threads)
+  {
+    worker.join();
+  }
+  threadedTrace.Flush();
+
+  ifstream threadedFile("./log/ThreadedBinaryTrace.bin", ios::binary);
+  const vector<char> threadedBytes((istreambuf_iterator<char>(threadedFile))
+      , istreambuf_iterator<char>());
+  MemTraceReader threadedReader(
+      reinterpret_cast<const uint8_t*>(threadedBytes.data())
+      , threadedBytes.size());
+
+  // Every thread's events are read back in the order it logged them
+  size_t nextEvent[numThreads] = {};
+  while(threadedReader.Next(record) == MEMERR_NO_ERR)
+  {
+    assert(record.memSize < numThreads);
+    const size_t t = record.memSize;
+    assert(record.address == ((t << 20) | (nextEvent[t] * 16)));
+    ++nextEvent[t];
+  }
+  assert(threadedReader.AtEnd());
+  for(size_t t = 0; t < numThreads; ++t)
+  {
+    assert(nextEvent[t] == numEvents);
+  }
+}
+
+void UnitTest_MemTrace_MappedFile()
+{
+  MEMERR error;
+  const size_t numOfMsgs = 1000;
+  {
+    MemTrace trace("./log/MappedTrace.txt", true, &error);
+    assert(error == MEMERR_NO_ERR);
+
+    // Use a small chunk so the mapping has to grow several times
+    error = trace.MapTraceFile(4096);
+#if defined(__unix__) || defined(__APPLE__)
+    assert(error == MEMERR_NO_ERR);
+#else
+    assert(error == MEMERR_INVALID_FILE);
+    return;
+#endif
+    assert(trace.MapTraceFile() == MEMERR_DOUBLE_ALLOC);
+    assert(trace.ClearFile() == MEMERR_INVALID_FUNCTION_PARAMETER);
+
+    for(size_t i = 0; i < numOfMsgs; ++i)
+    {
+      trace.LogMessage("Mapped Trace Log");
+    }
+
+    // Events are written as one message per line
+    for(size_t i = 0; i < numOfMsgs; ++i)
+    {
+      trace.LogEvent(MEMCALL_ALLOC, i);
+    }
+
+    // Including those of a heap logging through a callback
+    MemCallback callback(&trace);
+    MemHeap heap;
+    error = heap.InitalizeHeapMem(MemHeap::defaultPageSize
+        , MemHeap::defaultNumOfPages, MemHeap::defaultAllignment, &callback);
+    assert(error == MEMERR_NO_ERR);
+    int *p_int = nullptr;
+    heap.Allocate(p_int);
+    heap.Deallocate(p_int);
+    heap.TerminateHeapMem();
+
+    // Unmapping cuts the file down to what was written
+    error = trace.UnmapTraceFile();
+    assert(error == MEMERR_NO_ERR);
+    trace.LogMessage("Unmapped Trace Log");
+  }
+
+  vector<string> expectedLines(numOfMsgs, "Mapped Trace Log");
+  for(size_t i = 0; i < numOfMsgs; ++i)
+  {
+    expectedLines.push_back("Allocating Memory of size: " + to_string(i));
+  }
+  expectedLines.push_back("Allocating Memory of size: 4");
+  expectedLines.push_back("Deallocating Memory of size: 4");
+  expectedLines.push_back("Unmapped Trace Log");
+
+  ifstream file("./log/MappedTrace.txt", ios::binary);
+  string line;
+  size_t numOfLines = 0;
+  while(getline(file, line))
+  {
+    assert(numOfLines < expectedLines.size());
+    assert(line == expectedLines[numOfLines]);
+    ++numOfLines;
+  }
+  assert(numOfLines == expectedLines.size());
+  file.close();
+
+  // A text trace left padded by a crash is mapped again after its last line
+  {
+    ofstream crashedFile("./log/MappedTrace.txt"
+        , ios::binary | ios::app);
+    crashedFile << string(100, '\0');
+  }
+  {
+    MemTrace trace("./log/MappedTrace.txt", false, &error);
+    assert(error == MEMERR_NO_ERR);
+    error = trace.MapTraceFile(4096);
+    assert(error == MEMERR_NO_ERR);
+    trace.LogMessage("Remapped Trace Log");
+    error = trace.UnmapTraceFile();
+    assert(error == MEMERR_NO_ERR);
+  }
+  expectedLines.push_back("Remapped Trace Log");
+  file.open("./log/MappedTrace.txt", ios::binary);
+  numOfLines = 0;
+  while(getline(file, line))
+  {
+    assert(numOfLines < expectedLines.size());
+    assert(line == expectedLines[numOfLines]);
+    ++numOfLines;
+  }
+  assert(numOfLines == expectedLines.size());
+
+  // Several threads log binary events to a mapped file at once
+  MemTrace binaryTrace("./log/MappedBinaryTrace.bin", true, &error);
+  assert(error == MEMERR_NO_ERR);
+  binaryTrace.ClearFile();
+  error = binaryTrace.SetFormat(MEMTRACEFORMAT_BINARY);
+  assert(error == MEMERR_NO_ERR);
+  error = binaryTrace.MapTraceFile(4096);
+  assert(error == MEMERR_NO_ERR);
+
+  const size_t numThreads = 4;
+  const size_t numEvents = 1000;
+  vector<thread> threads;
+  for(size_t t = 0; t < numThreads; ++t)
+  {
+    threads.emplace_back([&binaryTrace, t]()
+    {
+      for(size_t i = 0; i < numEvents; ++i)
+      {
+        binaryTrace.LogEvent(MEMCALL_ALLOC, t
+            , reinterpret_cast<void*>((t << 20) | (i * 16)));
+      }
+    });
+  }
+  for(thread &worker : threads)
+  {
+    worker.join();
+  }
+
+  // Read the file while it is still mapped, as it would be left by a crash.
+  // It ends in zeroed padding which is read as the end of the trace.
+  {
+    ifstream binaryFile("./log/MappedBinaryTrace.bin", ios::binary);
+    const vector<char> bytes((istreambuf_iterator<char>(binaryFile))
+        , istreambuf_iterator<char>());
+    assert(bytes.size() % 4096 == 0);
+    assert(bytes.back() == 0);
+
+    MemTraceReader reader(reinterpret_cast<const uint8_t*>(bytes.data())
+        , bytes.size());
+    MemTraceRecord record;
+    size_t nextEvent[numThreads] = {};
+    while(reader.Next(record) == MEMERR_NO_ERR)
+    {
+      assert(record.type == MEMCALL_ALLOC);
+      assert(record.memSize < numThreads);
+      const size_t t = record.memSize;
+      assert(record.address == ((t << 20) | (nextEvent[t] * 16)));
+      ++nextEvent[t];
+    }
+    assert(reader.AtEnd());
+    for(size_t t = 0; t < numThreads; ++t)
+    {
+      assert(nextEvent[t] == numEvents);
+    }
+
+    // Keep a copy of the file as a crash would have left it
+    ofstream crashedFile("./log/CrashedBinaryTrace.bin"
+        , ios::binary | ios::trunc);
+    crashedFile.write(bytes.data(), bytes.size());
+  }
+
+  // Unmapping cuts the padding off
+  error = binaryTrace.UnmapTraceFile();
+  assert(error == MEMERR_NO_ERR);
+  {
+    ifstream binaryFile("./log/MappedBinaryTrace.bin", ios::binary);
+    const vector<char> bytes((istreambuf_iterator<char>(binaryFile))
+        , istreambuf_iterator<char>());
+    assert(!bytes.empty() && bytes.back() != 0);
+  }
+
+  // A new session mapped after the padding of the crashed trace is read
+  // as if the padding wasn't there
+  {
+    MemTrace trace("./log/CrashedBinaryTrace.bin", false, &error);
+    assert(error == MEMERR_NO_ERR);
+    error = trace.SetFormat(MEMTRACEFORMAT_BINARY);
+    assert(error == MEMERR_NO_ERR);
+    error = trace.MapTraceFile(4096);
+    assert(error == MEMERR_NO_ERR);
+    for(size_t i = 0; i < numEvents; ++i)
+    {
+      trace.LogEvent(MEMCALL_DEALLOC, i, reinterpret_cast<void*>(i * 16));
+    }
+    error = trace.UnmapTraceFile();
+    assert(error == MEMERR_NO_ERR);
+  }
+
+  ifstream crashedFile("./log/CrashedBinaryTrace.bin", ios::binary);
+  const vector<char> bytes((istreambuf_iterator<char>(crashedFile))
+      , istreambuf_iterator<char>());
+  MemTraceReader reader(reinterpret_cast<const uint8_t*>(bytes.data())
+      , bytes.size());
+  MemTraceRecord record;
+  size_t numOfAllocs = 0;
+  size_t numOfDeallocs = 0;
+  while((error = reader.Next(record)) == MEMERR_NO_ERR)
+  {
+    if(record.type == MEMCALL_ALLOC)
+    {
+      assert(!numOfDeallocs);
+      ++numOfAllocs;
+    }
+    else
+    {
+      assert(record.type == MEMCALL_DEALLOC);
+      assert(record.memSize == numOfDeallocs);
+      assert(record.address == numOfDeallocs * 16);
+      ++numOfDeallocs;
+    }
+  }
+  assert(error == MEMERR_INVALID_MEM);
+  assert(numOfAllocs == numThreads * numEvents);
+  assert(numOfDeallocs == numEvents);
+}
+
 // Callback test
 
 void UnitTest_MemCallback_SendConsoleCallbackMsg()
@@ -218,6 +756,65 @@ void UnitTest_MemCallback_SendConsoleCallbackMsg()
   assert(error == MEMERR_NO_ERR);
 }
 
+void UnitTest_MemCallback_Stats()
+{
+  // A callback without a trace only counts the messages it recieves
+  MemCallback callback;
+  const size_t numOfThreads = 4;
+  const size_t numOfCalls = 1000;
+
+  vector<thread> threads;
+  for(size_t i = 0; i < numOfThreads; ++i)
+  {
+    threads.emplace_back([&callback]()
+    {
+      for(size_t j = 0; j < numOfCalls; ++j)
+      {
+        callback.PerformCallback(MEMCALL_ALLOC, 16);
+        // Leave every fourth allocation in use
+        if(j % 4)
+        {
+          callback.PerformCallback(MEMCALL_DEALLOC, 16);
+        }
+      }
+      callback.PerformCallback(MEMCALL_MEM_ERR, 16);
+    });
+  }
+  for(thread &t : threads)
+  {
+    t.join();
+  }
+
+  const MemStats stats = callback.GetStats();
+  assert(stats.allocs == numOfThreads * numOfCalls);
+  assert(stats.deallocs == numOfThreads * numOfCalls * 3 / 4);
+  assert(stats.bytesAllocated == stats.allocs * 16);
+  assert(stats.bytesDeallocated == stats.deallocs * 16);
+  assert(stats.memInUse == numOfThreads * numOfCalls / 4 * 16);
+  assert(stats.errors == numOfThreads);
+
+  // Counters belong to each callback instead of being shared
+  MemCallback otherCallback;
+  assert(otherCallback.GetStats().allocs == 0);
+}
+
+void UnitTest_MemCallback_TraceBuffer()
+{
+  MemTrace trace("", false, nullptr, RecordMemTrace);
+  MemCallback callback(&trace);
+
+  MEMERR error = callback.PerformCallback(MEMCALL_ALLOC, 24);
+  assert(error == MEMERR_NO_ERR);
+  assert(recordedMsg == "Allocating Memory of size: 24");
+  const char *firstMsgData = recordedMsgData;
+
+  // Later messages are formatted into the same buffer without reallocating
+  error = callback.PerformCallback(MEMCALL_DEALLOC, SIZE_MAX);
+  assert(error == MEMERR_NO_ERR);
+  assert(recordedMsg == "Deallocating Memory of size: " + to_string(SIZE_MAX));
+  assert(recordedMsgData == firstMsgData);
+}
+
 // Test MemHeap
 
 void UnitTest_MemHeap_TestDefaults()
@@ -243,12 +840,1264 @@ void UnitTest_MemHeap_TestDefaults()
   assert(p_int == nullptr);
 }
 
-// Custom callbacks
+void UnitTest_MemHeap_ReuseFreedBlock()
+{
+  MemHeap heap;
 
-MEMERR CustomMemTrace(const string &msg, fstream *)
+  MEMERR error = heap.InitalizeHeapMem();
+
+  assert(error == MEMERR_NO_ERR);
+
+  // Allocate and free an object to place its block on a free list
+  int* p_int = nullptr;
+  heap.Allocate(p_int);
+  int* freedAddress = p_int;
+
+  error = heap.Deallocate(p_int);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(p_int == nullptr);
+
+  // An object of a different size class must not reuse the block
+  double* p_large = nullptr;
+  struct LargeObj { double values[4]; };
+  LargeObj* p_obj = nullptr;
+  heap.Allocate(p_obj);
+
+  assert(reinterpret_cast<void*>(p_obj) != freedAddress);
+
+  // An object of the same size class reuses the freed block
+  heap.Allocate(p_large);
+
+  assert(reinterpret_cast<void*>(p_large) == freedAddress);
+
+  // Churn the same class many times without running out of pages
+  for(size_t i = 0; i < MemHeap::defaultPageSize * MemHeap::defaultNumOfPages; ++i)
+  {
+    int* p_churn = nullptr;
+    error = heap.Allocate(p_churn);
+
+    assert(error == MEMERR_NO_ERR);
+
+    error = heap.Deallocate(p_churn);
+
+    assert(error == MEMERR_NO_ERR);
+  }
+
+  heap.Deallocate(p_large);
+  heap.Deallocate(p_obj);
+  heap.TerminateHeapMem();
+}
+
+void UnitTest_MemHeap_PagePlacement()
 {
-  // Ignores wether or not there is a file and print to the console
-  cout << "Trace: " << msg << endl;
+  MemHeap heap;
+
+  // Use small pages so that pages fill up quickly and limit the heap to
+  // 4 pages
+  const size_t pageSize = 64;
+  MEMERR error = heap.InitalizeHeapMem(pageSize, 4);
+
+  assert(error == MEMERR_NO_ERR);
+
+  error = heap.SetMemBudget(0, pageSize * 4);
+
+  assert(error == MEMERR_NO_ERR);
+
+  // Two 24 byte objects fill most of the first page leaving 16 bytes
+  struct MediumObj { uint8_t bytes[24]; };
+  MediumObj* p_first = nullptr;
+  MediumObj* p_second = nullptr;
+  heap.Allocate(p_first);
+  heap.Allocate(p_second);
+
+  uint8_t* firstPage = reinterpret_cast<uint8_t*>(p_first);
+  assert(reinterpret_cast<uint8_t*>(p_second) == firstPage + 24);
+
+  // A third medium object doesn't fit so it must go into a new page
+  MediumObj* p_third = nullptr;
+  error = heap.Allocate(p_third);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(reinterpret_cast<uint8_t*>(p_third) < firstPage
+      || reinterpret_cast<uint8_t*>(p_third) >= firstPage + pageSize);
+
+  // A small object still fits within the remaining space of the first page
+  uint64_t* p_small = nullptr;
+  heap.Allocate(p_small);
+
+  assert(reinterpret_cast<uint8_t*>(p_small) == firstPage + 48);
+
+  // Fill the remaining pages and make sure the heap reports when it is full
+  uint8_t* p_fill = nullptr;
+  do
+  {
+    p_fill = nullptr;
+    error = heap.Allocate(p_fill);
+  } while(error == MEMERR_NO_ERR);
+
+  assert(error == MEMERR_OUT_OF_MEM);
+  assert(heap.GetMemReserved() == pageSize * 4);
+
+  heap.TerminateHeapMem();
+}
+
+void UnitTest_MemHeap_GrowPageDirectory()
+{
+  MemHeap heap;
+
+  // Start with a single page in the directory so it has to grow
+  const size_t pageSize = 64;
+  MEMERR error = heap.InitalizeHeapMem(pageSize, 1);
+
+  assert(error == MEMERR_NO_ERR);
+
+  // Allocate enough objects to need thousands of pages
+  const size_t numOfObjs = 10000;
+  uint64_t** objs = new uint64_t*[numOfObjs];
+  for(size_t i = 0; i < numOfObjs; ++i)
+  {
+    objs[i] = nullptr;
+    error = heap.Allocate(objs[i]);
+
+    assert(error == MEMERR_NO_ERR);
+
+    *objs[i] = i;
+  }
+
+  // Make sure no object has been overwritten by another
+  for(size_t i = 0; i < numOfObjs; ++i)
+  {
+    assert(*objs[i] == i);
+  }
+
+  assert(heap.GetMemReserved() == pageSize * (numOfObjs / (pageSize / 8)));
+
+  // A soft budget below what is reserved lets allocations continue
+  error = heap.SetMemBudget(pageSize);
+
+  assert(error == MEMERR_NO_ERR);
+
+  uint64_t* p_extra = nullptr;
+  error = heap.Allocate(p_extra);
+
+  assert(error == MEMERR_NO_ERR);
+
+  // A soft budget above the hard budget is invalid
+  error = heap.SetMemBudget(pageSize * 2, pageSize);
+
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+
+  delete[] objs;
+  heap.TerminateHeapMem();
+}
+
+void UnitTest_MemHeap_Allignment()
+{
+  MemHeap heap;
+
+  MEMERR error = heap.InitalizeHeapMem();
+
+  assert(error == MEMERR_NO_ERR);
+
+  // Offset the page so the next block isn't already cache line alligned
+  uint8_t* p_byte = nullptr;
+  heap.Allocate(p_byte);
+
+  // A type with its own allignment is placed at that allignment
+  struct alignas(64) CacheLineObj { uint8_t bytes[64]; };
+  CacheLineObj* p_line = nullptr;
+  error = heap.Allocate(p_line);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(reinterpret_cast<uintptr_t>(p_line) % 64 == 0);
+
+  // An explicit allignment is honored for types that don't require it
+  float* p_vec = nullptr;
+  error = heap.Allocate(p_vec, 32);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(reinterpret_cast<uintptr_t>(p_vec) % 32 == 0);
+
+  // The padding skipped to reach an allignment never overlaps objects
+  assert(p_byte + 1 <= reinterpret_cast<uint8_t*>(p_line));
+
+  // An allignment that isn't a power of two is rejected
+  double* p_invalid = nullptr;
+  error = heap.Allocate(p_invalid, 24);
+
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+  assert(p_invalid == nullptr);
+
+  heap.TerminateHeapMem();
+}
+
+void UnitTest_MemHeap_Emplace()
+{
+  MemHeap heap;
+
+  MEMERR error = heap.InitalizeHeapMem();
+
+  assert(error == MEMERR_NO_ERR);
+
+  // A type that can only be constructed from its coordinates
+  struct Point
+  {
+    Point(int in_x, int in_y) : x(in_x), y(in_y) {}
+    Point(const Point &) = delete;
+    int x;
+    int y;
+  };
+
+  // Construct the object directly from its arguments
+  Point* p_point = nullptr;
+  error = heap.Emplace(p_point, 3, 4);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(p_point->x == 3 && p_point->y == 4);
+
+  // Arguments are forwarded so rvalues are moved into the object
+  string* p_string = nullptr;
+  string source(64, 'a');
+  error = heap.Emplace(p_string, std::move(source));
+
+  assert(error == MEMERR_NO_ERR);
+  assert(p_string->size() == 64);
+  assert(source.empty());
+
+  // Emplacing over an allocated pointer is still a double allocation
+  error = heap.Emplace(p_point, 1, 2);
+
+  assert(error == MEMERR_DOUBLE_ALLOC);
+
+  // Trivially constructible types can skip construction entirely
+  uint64_t* p_raw = nullptr;
+  error = heap.AllocateUninitalized(p_raw);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(p_raw != nullptr);
+
+  *p_raw = 7;
+
+  heap.Deallocate(p_raw);
+  heap.Deallocate(p_string);
+  heap.Deallocate(p_point);
+  heap.TerminateHeapMem();
+}
+
+void UnitTest_MemHeap_Array()
+{
+  MemHeap heap;
+
+  MEMERR error = heap.InitalizeHeapMem();
+
+  assert(error == MEMERR_NO_ERR);
+
+  // A small array of trivial records is zeroed within a page
+  struct Record { uint32_t id; float value; };
+  Record* p_small = nullptr;
+  error = heap.AllocateArray(p_small, 16);
+
+  assert(error == MEMERR_NO_ERR);
+  for(size_t i = 0; i < 16; ++i)
+  {
+    assert(p_small[i].id == 0 && p_small[i].value == 0.0f);
+  }
+
+  const size_t pagesReserved = heap.GetMemReserved();
+
+  // An array larger than a page gets a dedicated large page
+  const size_t largeCount = 4096;
+  Record* p_large = nullptr;
+  error = heap.AllocateArrayUninitalized(p_large, largeCount, 64);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(reinterpret_cast<uintptr_t>(p_large) % 64 == 0);
+  assert(heap.GetMemReserved() > pagesReserved + sizeof(Record) * largeCount);
+
+  for(size_t i = 0; i < largeCount; ++i)
+  {
+    p_large[i].id = static_cast<uint32_t>(i);
+  }
+
+  // Non trivial types have each object constructed and destroyed
+  string* p_strings = nullptr;
+  error = heap.AllocateArray(p_strings, 200);
+
+  assert(error == MEMERR_NO_ERR);
+  for(size_t i = 0; i < 200; ++i)
+  {
+    assert(p_strings[i].empty());
+    p_strings[i].assign(32, 'x');
+  }
+
+  // Releasing the large pages gives their memory back
+  error = heap.DeallocateArray(p_large, largeCount, 64);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(p_large == nullptr);
+
+  error = heap.DeallocateArray(p_strings, 200);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(heap.GetMemReserved() == pagesReserved);
+
+  // A freed small array is reused by the next array of its size class
+  Record* p_freed = p_small;
+  heap.DeallocateArray(p_small, 16);
+  error = heap.AllocateArray(p_small, 16);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(p_small == p_freed);
+
+  // Arrays must hold at least one object
+  Record* p_empty = nullptr;
+  error = heap.AllocateArray(p_empty, 0);
+
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+
+  heap.DeallocateArray(p_small, 16);
+  heap.TerminateHeapMem();
+}
+
+void UnitTest_MemHeap_MonotonicRewind()
+{
+  MemHeap heap;
+
+  // Create a monotonic heap that runs destructors when rewound
+  const size_t pageSize = 256;
+  MEMERR error = heap.InitalizeHeapMem(pageSize, 2, MemHeap::defaultAllignment
+      , nullptr, MEMFLAGS_MONOTONIC | MEMFLAGS_TRACK_DESTRUCTORS);
+
+  assert(error == MEMERR_NO_ERR);
+
+  // A type that counts how many times it has been destroyed
+  static size_t numDestroyed = 0;
+  struct Tracked
+  {
+    ~Tracked() { ++numDestroyed; }
+    uint64_t value = 0;
+  };
+
+  // Allocate something that lives for the whole test
+  uint64_t* p_kept = nullptr;
+  heap.Allocate(p_kept);
+  *p_kept = 42;
+
+  MemHeap::MemMarker marker = heap.GetMarker();
+  const size_t reservedAtMarker = heap.GetMemReserved();
+
+  // Allocate enough objects and arrays to spill over several pages
+  uint64_t* p_first = nullptr;
+  for(size_t i = 0; i < 100; ++i)
+  {
+    Tracked* p_tracked = nullptr;
+    error = heap.Allocate(p_tracked);
+
+    assert(error == MEMERR_NO_ERR);
+  }
+  heap.Allocate(p_first);
+
+  Tracked* p_arr = nullptr;
+  error = heap.AllocateArray(p_arr, 100);
+
+  assert(error == MEMERR_NO_ERR);
+
+  // Deallocating in a monotonic heap leaves the destructor to the rewind
+  Tracked* p_early = nullptr;
+  heap.Allocate(p_early);
+  heap.Deallocate(p_early);
+
+  assert(p_early == nullptr);
+  assert(numDestroyed == 0);
+
+  // Rewinding runs every destructor and releases the large page
+  error = heap.RewindTo(marker);
+
+  assert(error == MEMERR_NO_ERR);
+  assert(numDestroyed == 201);
+  assert(heap.GetMemReserved() < reservedAtMarker + sizeof(Tracked) * 100);
+  assert(*p_kept == 42);
+
+  // The memory after the marker is handed out again
+  uint64_t* p_again = nullptr;
+  for(size_t i = 0; i < 100; ++i)
+  {
+    Tracked* p_tracked = nullptr;
+    heap.Allocate(p_tracked);
+  }
+  heap.Allocate(p_again);
+
+  assert(p_again == p_first);
+
+  // A marker ahead of the heap can't be rewound to
+  error = heap.Reset();
+
+  assert(error == MEMERR_NO_ERR);
+
+  error = heap.RewindTo(marker);
+
+  assert(error == MEMERR_INVALID_MEM);
+
+  // Regular heaps can't be rewound
+  MemHeap regularHeap;
+  regularHeap.InitalizeHeapMem();
+  error = regularHeap.Reset();
+
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+
+  heap.TerminateHeapMem();
+}
+
+void UnitTest_MemHeap_ThreadSafe()
+{
+  MemHeap heap;
+
+  MEMERR error = heap.InitalizeHeapMem(MemHeap::defaultPageSize
+      , MemHeap::defaultNumOfPages, MemHeap::defaultAllignment, nullptr
+      , MEMFLAGS_THREAD_SAFE);
+
+  assert(error == MEMERR_NO_ERR);
+
+  // Monotonic heaps can't be shared between threads
+  MemHeap monotonicHeap;
+  error = monotonicHeap.InitalizeHeapMem(MemHeap::defaultPageSize
+      , MemHeap::defaultNumOfPages, MemHeap::defaultAllignment, nullptr
+      , MEMFLAGS_THREAD_SAFE | MEMFLAGS_MONOTONIC);
+
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+
+  // Every thread churns through its own objects while objects handed over
+  // from the previous round are freed by a different thread
+  const size_t numThreads = 4;
+  const size_t numObjs = 2000;
+  vector<uint64_t*> handedOver[numThreads];
+  for(size_t round = 0; round < 3; ++round)
+  {
+    vector<thread> threads;
+    vector<uint64_t*> produced[numThreads];
+    for(size_t t = 0; t < numThreads; ++t)
+    {
+      threads.emplace_back([&, t]()
+      {
+        // Free what another thread allocated last round
+        for(uint64_t* p_obj : handedOver[(t + 1) % numThreads])
+        {
+          const MEMERR freeError = heap.Deallocate(p_obj);
+          assert(freeError == MEMERR_NO_ERR);
+        }
+
+        for(size_t i = 0; i < numObjs; ++i)
+        {
+          uint64_t* p_obj = nullptr;
+          const MEMERR allocError = heap.Emplace(p_obj, t * numObjs + i);
+          assert(allocError == MEMERR_NO_ERR);
+          produced[t].push_back(p_obj);
+        }
+
+        // Make sure no other thread was handed the same blocks
+        for(size_t i = 0; i < numObjs; ++i)
+        {
+          assert(*produced[t][i] == t * numObjs + i);
+        }
+      });
+    }
+    for(thread &worker : threads)
+    {
+      worker.join();
+    }
+    for(size_t t = 0; t < numThreads; ++t)
+    {
+      handedOver[t] = produced[t];
+    }
+  }
+
+  // Blocks cached by exited threads are reused instead of growing the heap
+  const size_t reserved = heap.GetMemReserved();
+  for(size_t t = 0; t < numThreads; ++t)
+  {
+    for(uint64_t* p_obj : handedOver[t])
+    {
+      heap.Deallocate(p_obj);
+    }
+  }
+  thread reuser([&]()
+  {
+    for(size_t i = 0; i < numObjs; ++i)
+    {
+      uint64_t* p_obj = nullptr;
+      heap.Allocate(p_obj);
+    }
+  });
+  reuser.join();
+
+  assert(heap.GetMemReserved() == reserved);
+
+  heap.TerminateHeapMem();
+}
+
+void UnitTest_MemHeap_RemoteFree()
+{
+  MemHeap heap;
+
+  MEMERR error = heap.InitalizeHeapMem(MemHeap::defaultPageSize
+      , MemHeap::defaultNumOfPages, MemHeap::defaultAllignment, nullptr
+      , MEMFLAGS_THREAD_SAFE);
+
+  assert(error == MEMERR_NO_ERR);
+
+  // Thread safe heaps need a page size that is a power of two
+  MemHeap invalidHeap;
+  error = invalidHeap.InitalizeHeapMem(1000, 1, MemHeap::defaultAllignment
+      , nullptr, MEMFLAGS_THREAD_SAFE);
+
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+
+  const size_t numObjs = 500;
+  vector<uint64_t*> produced;
+  atomic<int> stage(0);
+
+  // The producer allocates objects and hands them to the consumer
+  thread producer([&]()
+  {
+    for(size_t i = 0; i < numObjs; ++i)
+    {
+      uint64_t* p_obj = nullptr;
+      heap.Allocate(p_obj);
+      produced.push_back(p_obj);
+    }
+    stage.store(1);
+
+    // Wait for the consumer to free everything
+    while(stage.load() != 2)
+    {
+      this_thread::yield();
+    }
+
+    // The freed blocks are drained back into the producer's allocations
+    vector<uint64_t*> original = produced;
+    sort(original.begin(), original.end());
+    for(size_t i = 0; i < numObjs; ++i)
+    {
+      uint64_t* p_obj = nullptr;
+      heap.Allocate(p_obj);
+
+      assert(binary_search(original.begin(), original.end(), p_obj));
+    }
+  });
+
+  // The consumer frees the objects from a different thread
+  thread consumer([&]()
+  {
+    while(stage.load() != 1)
+    {
+      this_thread::yield();
+    }
+    for(uint64_t* p_obj : produced)
+    {
+      const MEMERR freeError = heap.Deallocate(p_obj);
+      assert(freeError == MEMERR_NO_ERR);
+    }
+    stage.store(2);
+  });
+
+  producer.join();
+  consumer.join();
+
+  heap.TerminateHeapMem();
+}
+
+void UnitTest_MemHeap_CallbackPolicy()
+{
+  // A counting heap keeps its own counts without a callback class
+  MEMERR error = countingHeap.InitalizeHeapMem();
+  assert(error == MEMERR_NO_ERR);
+
+  int *p_int = nullptr;
+  error = countingHeap.Allocate(p_int);
+  assert(error == MEMERR_NO_ERR);
+  error = countingHeap.Deallocate(p_int);
+  assert(error == MEMERR_NO_ERR);
+
+  // Deallocating nothing is still counted as an error
+  error = countingHeap.Deallocate(p_int);
+  assert(error == MEMERR_INVALID_MEM);
+
+  {
+    // Handles can be bound to heaps of any policy
+    StaticMem<double, &countingHeap> handle;
+    error = handle.Emplace(2.0);
+    assert(error == MEMERR_NO_ERR);
+  }
+
+  MemStats stats = countingHeap.GetPolicy().GetStats();
+  assert(stats.allocs == 2);
+  assert(stats.deallocs == 2);
+  assert(stats.bytesAllocated == sizeof(int) + sizeof(double));
+  assert(stats.memInUse == 0);
+  assert(stats.errors == 1);
+
+  // Plain counters can't be shared between threads
+  BasicMemHeap<CountingPolicy<>> sharedHeap;
+  error = sharedHeap.InitalizeHeapMem(MemHeap::defaultPageSize
+      , MemHeap::defaultNumOfPages, MemHeap::defaultAllignment, nullptr
+      , MEMFLAGS_THREAD_SAFE);
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+
+  BasicMemHeap<CountingPolicy<true>> atomicHeap;
+  error = atomicHeap.InitalizeHeapMem(MemHeap::defaultPageSize
+      , MemHeap::defaultNumOfPages, MemHeap::defaultAllignment, nullptr
+      , MEMFLAGS_THREAD_SAFE);
+  assert(error == MEMERR_NO_ERR);
+
+  // A null heap ignores the callback it is given
+  MemCallback callback;
+  BasicMemHeap<NullPolicy> nullHeap;
+  error = nullHeap.InitalizeHeapMem(MemHeap::defaultPageSize
+      , MemHeap::defaultNumOfPages, MemHeap::defaultAllignment, &callback);
+  assert(error == MEMERR_NO_ERR);
+
+  error = nullHeap.Allocate(p_int);
+  assert(error == MEMERR_NO_ERR);
+  nullHeap.Deallocate(p_int);
+  assert(callback.GetStats().allocs == 0);
+
+  countingHeap.TerminateHeapMem();
+}
+
+void UnitTest_MemHeap_Allocators()
+{
+  BasicMemHeap<CountingPolicy<>> heap;
+  MEMERR error = heap.InitalizeHeapMem();
+  assert(error == MEMERR_NO_ERR);
+
+#ifdef MEMSTAX_MEMORY_RESOURCE
+  {
+    // Containers of every kind draw their memory from the heap through a
+    // memory resource, including vectors larger than a page
+    BasicMemHeapResource<CountingPolicy<>> resource(&heap);
+    pmr::vector<int> values(&resource);
+    for(int i = 0; i < 1000; ++i)
+    {
+      values.push_back(i);
+    }
+    assert(values[999] == 999);
+
+    pmr::unordered_map<int, pmr::string> names(&resource);
+    for(int i = 0; i < 64; ++i)
+    {
+      names.emplace(i, "A string long enough to need its own allocation");
+    }
+    assert(names.at(63).get_allocator().resource() == &resource);
+
+    // Resources sharing a heap can free each other's memory
+    BasicMemHeapResource<CountingPolicy<>> otherResource(&heap);
+    assert(resource.is_equal(otherResource));
+    assert(heap.GetPolicy().GetStats().allocs > 64);
+  }
+  assert(heap.GetPolicy().GetStats().memInUse == 0);
+
+  // Allocations that can't be made throw as the standard requires
+  bool threw = false;
+  BasicMemHeap<CountingPolicy<>> uninitalizedHeap;
+  BasicMemHeapResource<CountingPolicy<>> badResource(&uninitalizedHeap);
+  void *badMem = nullptr;
+  try
+  {
+    badMem = badResource.allocate(16);
+  }
+  catch(const bad_alloc &)
+  {
+    threw = true;
+  }
+  assert(threw && !badMem);
+#endif
+
+  {
+    // Allocators are rebound to the nodes of node based containers
+    Allocator<int, CountingPolicy<>> allocator(&heap);
+    vector<int, Allocator<int, CountingPolicy<>>> values(allocator);
+    values.assign(500, 7);
+    list<double, Allocator<double, CountingPolicy<>>> nodes(allocator);
+    nodes.push_back(1.0);
+    nodes.push_back(2.0);
+    assert(nodes.get_allocator() == allocator);
+    assert(heap.GetPolicy().GetStats().memInUse > 500 * sizeof(int));
+  }
+  assert(heap.GetPolicy().GetStats().memInUse == 0);
+
+  // Untyped memory is alligned as requested
+  void *mem = nullptr;
+  error = heap.AllocateBytes(mem, 24, 64);
+  assert(error == MEMERR_NO_ERR);
+  assert(reinterpret_cast<uintptr_t>(mem) % 64 == 0);
+  error = heap.DeallocateBytes(mem, 24, 64);
+  assert(error == MEMERR_NO_ERR && !mem);
+}
+
+void UnitTest_MemHeap_Slab()
+{
+  // Slabs need pages that are a power of two and can't be shared
+  MemHeap heap;
+  MEMERR error = heap.InitalizeHeapMem(1000, MemHeap::defaultNumOfPages
+      , MemHeap::defaultAllignment, nullptr, MEMFLAGS_SLAB);
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+  error = heap.InitalizeHeapMem(1024, MemHeap::defaultNumOfPages
+      , MemHeap::defaultAllignment, nullptr
+      , MEMFLAGS_SLAB | MEMFLAGS_THREAD_SAFE);
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+
+  error = heap.InitalizeHeapMem(1024, MemHeap::defaultNumOfPages
+      , MemHeap::defaultAllignment, nullptr
+      , MEMFLAGS_SLAB | MEMFLAGS_DISABLE_DEBUG_MSG);
+  assert(error == MEMERR_NO_ERR);
+
+  // Objects of one class are packed next to each other
+  const size_t pageMask = ~static_cast<uintptr_t>(1023);
+  uint64_t *values[200] = {};
+  for(size_t i = 0; i < 200; ++i)
+  {
+    error = heap.Allocate(values[i]);
+    assert(error == MEMERR_NO_ERR);
+    *values[i] = i;
+  }
+  assert(values[1] == values[0] + 1);
+  assert(heap.CountLiveBlocks() == 200);
+
+  // Walking visits every live block in address order within each slab
+  size_t numOfVisited = 0;
+  uint64_t sum = 0;
+  error = heap.ForEachLiveBlock([&](void *block, const size_t &slotSize)
+      {
+        assert(slotSize == sizeof(uint64_t));
+        sum += *static_cast<uint64_t*>(block);
+        ++numOfVisited;
+      });
+  assert(error == MEMERR_NO_ERR);
+  assert(numOfVisited == 200 && sum == 199 * 200 / 2);
+
+  // The lowest free slot is handed out first
+  uint64_t *freed = values[10];
+  heap.Deallocate(values[10]);
+  heap.Deallocate(values[12]);
+  assert(heap.CountLiveBlocks() == 198);
+  error = heap.Allocate(values[10]);
+  assert(error == MEMERR_NO_ERR && values[10] == freed);
+  error = heap.Allocate(values[12]);
+  assert(error == MEMERR_NO_ERR);
+
+  // Empty slabs go back to the pool for any class to take, except for the
+  // last slab of a class, so pairs fill the first page the values emptied
+  const uintptr_t firstPage = reinterpret_cast<uintptr_t>(values[0]) 
+    & pageMask;
+  for(uint64_t *&value : values)
+  {
+    heap.Deallocate(value);
+  }
+  assert(heap.CountLiveBlocks() == 0);
+  const size_t memReserved = heap.GetMemReserved();
+
+  struct Pair
+  {
+    double first;
+    double second;
+  };
+  Pair *pairs[60] = {};
+  bool reusedFirstPage = false;
+  for(Pair *&pair : pairs)
+  {
+    error = heap.Allocate(pair);
+    assert(error == MEMERR_NO_ERR);
+    reusedFirstPage |= (reinterpret_cast<uintptr_t>(pair) & pageMask) 
+      == firstPage;
+  }
+  assert(reusedFirstPage && heap.GetMemReserved() == memReserved);
+
+  // Over-alligned objects land on alligned slots
+  double *p_alligned = nullptr;
+  error = heap.Allocate(p_alligned, 64);
+  assert(error == MEMERR_NO_ERR);
+  assert(reinterpret_cast<uintptr_t>(p_alligned) % 64 == 0);
+  heap.Deallocate(p_alligned);
+
+  // Arrays too large for a slab still get a large page
+  uint8_t *p_large = nullptr;
+  error = heap.AllocateArray(p_large, 4096);
+  assert(error == MEMERR_NO_ERR);
+  assert(heap.CountLiveBlocks() == 60);
+  heap.DeallocateArray(p_large, 4096);
+
+  for(Pair *&pair : pairs)
+  {
+    heap.Deallocate(pair);
+  }
+
+  // Large slabs have long bitmaps that are scanned many words at a time
+  BasicMemHeap<NullPolicy> bigHeap;
+  error = bigHeap.InitalizeHeapMem(64 * 1024, MemHeap::defaultNumOfPages
+      , MemHeap::defaultAllignment, nullptr, MEMFLAGS_SLAB);
+  assert(error == MEMERR_NO_ERR);
+  vector<uint64_t*> many(6000, nullptr);
+  for(uint64_t *&value : many)
+  {
+    error = bigHeap.Allocate(value);
+    assert(error == MEMERR_NO_ERR);
+  }
+  freed = many[5000];
+  bigHeap.Deallocate(many[5000]);
+  bigHeap.Deallocate(many[5500]);
+  error = bigHeap.Allocate(many[5000]);
+  assert(error == MEMERR_NO_ERR && many[5000] == freed);
+  assert(bigHeap.CountLiveBlocks() == 5999);
+
+  // Walking is only avaliable to slab heaps
+  MemHeap plainHeap;
+  plainHeap.InitalizeHeapMem();
+  error = plainHeap.ForEachLiveBlock([](void *, const size_t &) {});
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+}
+
+void UnitTest_MemHeap_Buddy()
+{
+  // Buddy regions need pages that are a power of two
+  MemHeap heap;
+  MEMERR error = heap.InitalizeHeapMem(1000, MemHeap::defaultNumOfPages
+      , MemHeap::defaultAllignment, nullptr, MEMFLAGS_BUDDY);
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+  error = heap.InitalizeHeapMem(1024, MemHeap::defaultNumOfPages
+      , MemHeap::defaultAllignment, nullptr, MEMFLAGS_BUDDY | MEMFLAGS_SLAB);
+  assert(error == MEMERR_INVALID_FUNCTION_PARAMETER);
+
+  // A single megabyte region serves request buffers of every size
+  const size_t regionSize = 1024 * 1024;
+  error = heap.InitalizeHeapMem(regionSize, MemHeap::defaultNumOfPages
+      , MemHeap::defaultAllignment, nullptr
+      , MEMFLAGS_BUDDY | MEMFLAGS_DISABLE_DEBUG_MSG);
+  assert(error == MEMERR_NO_ERR);
+  const size_t memReserved = heap.GetMemReserved();
+
+  const size_t sizes[] = { 64, 100, 4096, 3000, 256 * 1024, 64, 16 * 1024 };
+  void *buffers[sizeof(sizes) / sizeof(size_t)] = {};
+  for(size_t i = 0; i < sizeof(sizes) / sizeof(size_t); ++i)
+  {
+    error = heap.AllocateBytes(buffers[i], sizes[i]);
+    assert(error == MEMERR_NO_ERR);
+    std::memset(buffers[i], static_cast<int>(i), sizes[i]);
+
+    // Blocks are alligned to their power of two size
+    size_t blockSize = 1;
+    while(blockSize < sizes[i])
+    {
+      blockSize *= 2;
+    }
+    assert(reinterpret_cast<uintptr_t>(buffers[i]) % blockSize == 0);
+  }
+  assert(heap.GetMemReserved() == memReserved);
+  assert(static_cast<uint8_t*>(buffers[4])[256 * 1024 - 1] == 4);
+
+  // Over-alligned objects are freed by their address alone
+  double *p_alligned = nullptr;
+  error = heap.Allocate(p_alligned, 256);
+  assert(error == MEMERR_NO_ERR);
+  assert(reinterpret_cast<uintptr_t>(p_alligned) % 256 == 0);
+  heap.Deallocate(p_alligned);
+
+  // Once everything is freed the buddies merge back into the largest block
+  for(size_t i = 0; i < sizeof(sizes) / sizeof(size_t); ++i)
+  {
+    error = heap.DeallocateBytes(buffers[i], sizes[i]);
+    assert(error == MEMERR_NO_ERR);
+  }
+  void *half = nullptr;
+  error = heap.AllocateBytes(half, regionSize / 2);
+  assert(error == MEMERR_NO_ERR);
+  assert(heap.GetMemReserved() == memReserved);
+
+  // Only another region can fit a second half
+  void *otherHalf = nullptr;
+  error = heap.AllocateBytes(otherHalf, regionSize / 2);
+  assert(error == MEMERR_NO_ERR);
+  assert(heap.GetMemReserved() == memReserved * 2);
+
+  // Anything larger than half a region gets a large page
+  uint8_t *p_large = nullptr;
+  error = heap.AllocateArray(p_large, regionSize);
+  assert(error == MEMERR_NO_ERR);
+  heap.DeallocateArray(p_large, regionSize);
+
+  heap.DeallocateBytes(half, regionSize / 2);
+  heap.DeallocateBytes(otherHalf, regionSize / 2);
+
+  // Objects larger than a page are refused instead of overrunning it
+  struct Large
+  {
+    uint8_t bytes[2048];
+  };
+  MemHeap smallHeap;
+  smallHeap.InitalizeHeapMem(1024, MemHeap::defaultNumOfPages
+      , MemHeap::defaultAllignment, nullptr, MEMFLAGS_BUDDY);
+  Large *p_obj = nullptr;
+  error = smallHeap.Allocate(p_obj);
+  assert(error == MEMERR_OUT_OF_MEM && !p_obj);
+}
+
+// Test StaticMem
+
+void UnitTest_StaticMem_Ownership()
+{
+  // Handles bound to a global heap are only the size of a pointer
+  static_assert(sizeof(StaticMem<uint64_t, &globalHeap>) == sizeof(uint64_t*)
+      , "A bound StaticMem must be the size of a pointer");
+
+  MEMERR error = globalHeap.InitalizeHeapMem();
+
+  assert(error == MEMERR_NO_ERR);
+
+  uint64_t* p_freed = nullptr;
+  {
+    // Create an object owned by the handle
+    StaticMem<uint64_t, &globalHeap> handle;
+    error = handle.Emplace(7u);
+
+    assert(error == MEMERR_NO_ERR);
+    assert(handle && *handle == 7);
+
+    // A handle can't own two objects at once
+    error = handle.Emplace(8u);
+
+    assert(error == MEMERR_DOUBLE_ALLOC);
+
+    // Moving hands the object over without copying it
+    StaticMem<uint64_t, &globalHeap> moved(std::move(handle));
+
+    assert(!handle);
+    assert(*moved == 7);
+
+    p_freed = moved.Get();
+  }
+
+  // The object is returned to the heap once the owner leaves scope
+  uint64_t* p_reused = nullptr;
+  globalHeap.Allocate(p_reused);
+
+  assert(p_reused == p_freed);
+
+  globalHeap.Deallocate(p_reused);
+
+  // Handles can also be given a heap at runtime
+  MemHeap heap;
+  heap.InitalizeHeapMem();
+  StaticMem<string> runtimeHandle(heap);
+  error = runtimeHandle.Emplace("runtime");
+
+  assert(error == MEMERR_NO_ERR);
+  assert(runtimeHandle->size() == 7);
+
+  runtimeHandle.Deallocate();
+
+  assert(!runtimeHandle);
+
+  globalHeap.TerminateHeapMem();
+}
+
+// Test StackArena
+
+void UnitTest_StackArena_Spill()
+{
+  StackArena<256, CountingPolicy<>> arena;
+
+  // Small allocations come from the buffer within the arena
+  uint32_t *p_values = nullptr;
+  MEMERR error = arena.AllocateArray(p_values, 32);
+  assert(error == MEMERR_NO_ERR);
+  assert(arena.InBuffer(p_values) && arena.GetBufferUsed() == 128);
+  assert(p_values[31] == 0);
+
+  // Over-alligned objects are alligned within the buffer
+  double *p_double = nullptr;
+  error = arena.Allocate(p_double, 64);
+  assert(error == MEMERR_NO_ERR);
+  assert(arena.InBuffer(p_double));
+  assert(reinterpret_cast<uintptr_t>(p_double) % 64 == 0);
+
+  // The most recent allocation gives its memory back like a stack
+  const size_t usedBefore = arena.GetBufferUsed();
+  string *p_string = nullptr;
+  error = arena.Emplace(p_string, "scratch");
+  assert(error == MEMERR_NO_ERR && *p_string == "scratch");
+  assert(arena.InBuffer(p_string));
+  error = arena.Deallocate(p_string);
+  assert(error == MEMERR_NO_ERR && !p_string);
+  assert(arena.GetBufferUsed() == usedBefore);
+
+  // Allocations that don't fit spill to heap pages
+  assert(!arena.HasSpilled());
+  uint32_t *p_large = nullptr;
+  error = arena.AllocateArray(p_large, 2048);
+  assert(error == MEMERR_NO_ERR);
+  assert(!arena.InBuffer(p_large) && arena.HasSpilled());
+  p_large[2047] = 7;
+  error = arena.DeallocateArray(p_large, 2048);
+  assert(error == MEMERR_NO_ERR);
+
+  // Allocating over an existing object is still caught
+  error = arena.Allocate(p_double);
+  assert(error == MEMERR_DOUBLE_ALLOC);
+
+  MemStats stats = arena.GetPolicy().GetStats();
+  assert(stats.allocs == 4 && stats.deallocs == 2);
+
+  // Resetting gives back the buffer and the spilled pages at once
+  arena.Reset();
+  assert(arena.GetBufferUsed() == 0 && !arena.HasSpilled());
+}
+
+// Test MemPool
+
+void UnitTest_MemPool_FreeList()
+{
+  struct Order
+  {
+    uint64_t id;
+    double price;
+    uint32_t quantity;
+  };
+
+  MEMERR error = globalHeap.InitalizeHeapMem();
+  assert(error == MEMERR_NO_ERR);
+
+  {
+    MemPool<Order, &globalHeap> pool(4);
+
+    // Slots of a chunk are handed out contiguously
+    Order *orders[6] = {};
+    for(Order *&order : orders)
+    {
+      error = pool.Emplace(order, Order{ 1, 2.0, 3 });
+      assert(error == MEMERR_NO_ERR && order->quantity == 3);
+    }
+    assert(orders[1] == orders[0] + 1 && orders[3] == orders[2] + 1);
+    assert(pool.GetNumOfChunks() == 2 && pool.GetNumOfLive() == 6);
+
+    // The most recently freed slot is handed out first
+    Order *freed = orders[2];
+    error = pool.Deallocate(orders[2]);
+    assert(error == MEMERR_NO_ERR && !orders[2]);
+    error = pool.Allocate(orders[2]);
+    assert(error == MEMERR_NO_ERR && orders[2] == freed);
+    assert(orders[2]->id == 0);
+
+    error = pool.Allocate(orders[2]);
+    assert(error == MEMERR_DOUBLE_ALLOC);
+
+    for(Order *&order : orders)
+    {
+      pool.Deallocate(order);
+    }
+    assert(pool.GetNumOfLive() == 0);
+  }
+
+  {
+    // A slot whose constructor throws anything is given back to the pool
+    struct Part
+    {
+      Part(int in_id)
+      {
+        if(in_id < 0)
+        {
+          throw in_id;
+        }
+      }
+    };
+    MemPool<Part, &globalHeap> pool(4);
+
+    Part *part = nullptr;
+    error = pool.Emplace(part, -1);
+    assert(error == MEMERR_UNKNOWN && !part);
+    assert(pool.GetNumOfLive() == 0);
+
+    Part *parts[4] = {};
+    for(Part *&next : parts)
+    {
+      error = pool.Emplace(next, 1);
+      assert(error == MEMERR_NO_ERR);
+    }
+    assert(pool.GetNumOfChunks() == 1);
+    for(Part *&next : parts)
+    {
+      pool.Deallocate(next);
+    }
+  }
+
+  // Callbacks are only sent once a policy that sends them is chosen
+  MemCallback callback;
+  MemPool<Order, nullptr, MemCallbackPolicy> pool(globalHeap);
+  error = pool.SetCallback(&callback);
+  assert(error == MEMERR_NO_ERR);
+
+  Order *order = nullptr;
+  error = pool.Allocate(order);
+  assert(error == MEMERR_NO_ERR);
+  pool.Deallocate(order);
+  assert(callback.GetStats().allocs == 1 && callback.GetStats().deallocs == 1);
+
+  pool.ReleasePool();
+  globalHeap.TerminateHeapMem();
+}
+
+// Test DynamicMem
+
+void UnitTest_DynamicMem_SharedOwnership()
+{
+  // Shared handles are only the size of a pointer
+  static_assert(sizeof(DynamicMem<string>) == sizeof(string*)
+      , "A DynamicMem must be the size of a pointer");
+
+  MemHeap heap;
+  MEMERR error = heap.InitalizeHeapMem();
+
+  assert(error == MEMERR_NO_ERR);
+
+  // A type that counts how many times it has been destroyed
+  static size_t numDestroyed = 0;
+  struct Node
+  {
+    Node(int in_value) : value(in_value)
+    {
+      if(in_value < 0)
+      {
+        throw in_value;
+      }
+    }
+    ~Node() { ++numDestroyed; }
+    int value;
+  };
+
+  {
+    DynamicMem<Node> first;
+    error = first.Emplace(heap, 5);
+
+    assert(error == MEMERR_NO_ERR);
+    assert(first->value == 5 && first.UseCount() == 1);
+
+    {
+      // Copies share the same object
+      DynamicMem<Node> second(first);
+      DynamicMem<Node> third;
+      third = second;
+
+      assert(third.Get() == first.Get());
+      assert(first.UseCount() == 3);
+
+      // Moving doesn't change the count
+      DynamicMem<Node> moved(std::move(third));
+
+      assert(!third && first.UseCount() == 3);
+    }
+
+    // The object lives until the last handle lets go
+    assert(first.UseCount() == 1);
+    assert(numDestroyed == 0);
+  }
+
+  assert(numDestroyed == 1);
+
+  {
+    // A constructor throwing something other than an exception leaves the
+    // handle empty instead of holding an unconstructed object
+    DynamicMem<Node> failed;
+    error = failed.Emplace(heap, -1);
+
+    assert(error == MEMERR_UNKNOWN);
+    assert(!failed);
+  }
+
+  assert(numDestroyed == 1);
+
+  // Atomic handles bound to a global heap behave the same way
+  globalHeap.InitalizeHeapMem();
+  {
+    AtomicDynamicMem<Node, &globalHeap> shared;
+    error = shared.EmplaceBound(9);
+
+    assert(error == MEMERR_NO_ERR);
+
+    AtomicDynamicMem<Node, &globalHeap> copy = shared;
+
+    assert(copy.UseCount() == 2 && copy->value == 9);
+  }
+
+  assert(numDestroyed == 2);
+
+  globalHeap.TerminateHeapMem();
+}
+
+void UnitTest_DynamicMem_WeakReference()
+{
+  MemHeap heap;
+  MEMERR error = heap.InitalizeHeapMem();
+
+  assert(error == MEMERR_NO_ERR);
+
+  DynamicWeak<string> weak;
+  string* p_slot = nullptr;
+  {
+    DynamicMem<string> strong;
+    strong.Emplace(heap, "cached entry");
+    p_slot = strong.Get();
+    weak = DynamicWeak<string>(strong);
+
+    // Locking a live object shares it
+    DynamicMem<string> locked = weak.Lock();
+
+    assert(locked && *locked == "cached entry");
+    assert(strong.UseCount() == 2);
+    assert(!weak.Expired());
+  }
+
+  // The object is gone once the strong handles are
+  assert(weak.Expired());
+  assert(!weak.Lock());
+
+  // The weak reference still pins the slot so it isn't reused
+  DynamicMem<string> other;
+  other.Emplace(heap, "other entry");
+
+  assert(other.Get() != p_slot);
+
+  // Dropping the last weak reference gives the slot back
+  weak.Deallocate();
+  DynamicMem<string> reused;
+  reused.Emplace(heap, "reused entry");
+
+  assert(reused.Get() == p_slot);
+
+  // Atomic weak references lock the same way
+  AtomicDynamicMem<int> atomicStrong;
+  atomicStrong.Emplace(heap, 3);
+  AtomicDynamicWeak<int> atomicWeak(atomicStrong);
+
+  assert(*atomicWeak.Lock() == 3);
+
+  atomicStrong.Deallocate();
+
+  assert(!atomicWeak.Lock());
+}
+
+// Custom callbacks
+
+MEMERR CustomMemTrace(const string &msg, fstream *)
+{
+  // Ignores wether or not there is a file and print to the console
+  cout << "Trace: " << msg << endl;
+
+  return MEMERR_NO_ERR;
+}
+
+MEMERR RecordMemTrace(const string &msg, fstream *)
+{
+  recordedMsg = msg;
+  recordedMsgData = msg.data();
 
   return MEMERR_NO_ERR;
 }